@@ -0,0 +1,152 @@
+#
+# Benchmarks for the functions in  transversalproperties.g  and the
+# external program  tpexternal.c.
+#
+# To run the benchmarks, start GAP in the top directory of this
+# repository, read in  transversalproperties.g  (with
+# TRANSVERSALPROPERTIES_tpexternal_exe  set as described there),
+# and then read in this file, for example with:
+#
+#    gap> Read("transversalproperties.g");
+#    gap> Read("bench/benchmark.g");
+#    gap> TransversalPropertiesBenchmark(TRANSVERSALPROPERTIES_bench_cases,
+#    >       "bench/results.txt");
+#
+# To make the standalone inputs for  tpexternal  (which can then be
+# timed without GAP, by  bench/run.sh),  use:
+#
+#    gap> TransversalPropertiesBenchmarkInputs(
+#    >       TRANSVERSALPROPERTIES_bench_cases,"bench/inputs");
+#
+# The same cases (with the same settings of the global variables
+# in  transversalproperties.g)  should be used for the runs compared.
+#
+
+TRANSVERSALPROPERTIES_bench_cases:=[
+   rec(name:="PSL(2,19)", group:=function() return PSL(2,19); end,
+       ut:=[3,4,5], et:=[4,5,6], sut:=[3,4]),
+   rec(name:="PGL(2,23)", group:=function() return PGL(2,23); end,
+       ut:=[3,4,5], et:=[4,5,6], sut:=[3]),
+   rec(name:="M24", group:=function() return MathieuGroup(24); end,
+       ut:=[5,6], et:=[6], sut:=[4,5]),
+   rec(name:="PGL(2,49)", group:=function() return PGL(2,49); end,
+       ut:=[3,4], et:=[4,5], sut:=[3]),
+   rec(name:="PSL(2,101)", group:=function() return PSL(2,101); end,
+       ut:=[3,4], et:=[4], sut:=[]),
+   rec(name:="PGL(2,197)", group:=function() return PGL(2,197); end,
+       ut:=[3], et:=[3,4], sut:=[])
+];
+# The benchmark cases. For each case, the lists  ut,  et  and  sut
+# give the values of  k  for which  UniversalTransversalProperty,
+# ExistentialTransversalProperty  and  StrongUniversalTransversalProperty
+# are run for the group (of degree 20 to 198) made by  group().
+
+TransversalPropertiesBenchmark := function(cases,filename)
+#
+# Runs the benchmarks given by the list  cases  (in the format of
+# TRANSVERSALPROPERTIES_bench_cases),  and appends a line for each
+# run to the file  filename,  giving: the case name, the property
+# (ut, et or sut),  k,  the result, the wall-clock time and the CPU
+# time (of GAP and its child processes) in milliseconds, and the
+# number of runs of tpexternal, the total number of nodes searched by
+# these, and their peak memory (in kilobytes). The lines are also
+# printed, and the list of the records for the runs is returned.
+#
+local results,case,G,prop,func,k,wall,cpu,t,result,stats,r,line;
+results:=[];
+for case in cases do
+   G:=case.group();
+   for prop in ["ut","et","sut"] do
+      if prop="ut" then
+         func:=UniversalTransversalProperty;
+      elif prop="et" then
+         func:=ExistentialTransversalProperty;
+      else
+         func:=StrongUniversalTransversalProperty;
+      fi;
+      for k in case.(prop) do
+         TRANSVERSALPROPERTIES_tpexternal_statistics:=[];
+         t:=Runtimes();
+         cpu:=t.user_time+t.system_time+t.user_time_children
+            +t.system_time_children;
+         wall:=NanosecondsSinceEpoch();
+         result:=func(G,k);
+         wall:=QuoInt(NanosecondsSinceEpoch()-wall,1000000);
+         t:=Runtimes();
+         cpu:=t.user_time+t.system_time+t.user_time_children
+            +t.system_time_children-cpu;
+         stats:=TRANSVERSALPROPERTIES_tpexternal_statistics;
+         TRANSVERSALPROPERTIES_tpexternal_statistics:=fail;
+         r:=rec(name:=case.name,property:=prop,k:=k,result:=result,
+            wallms:=wall,cpums:=cpu,runs:=Length(stats),
+            nodes:=Sum(stats,x->x.nodes),
+            maxrsskb:=Maximum(Concatenation([0],List(stats,x->x.maxrsskb))));
+         Add(results,r);
+         line:=JoinStringsWithSeparator(List([r.name,r.property,r.k,
+            r.result,r.wallms,r.cpums,r.runs,r.nodes,r.maxrsskb],String),
+            " ");
+         Print(line,"\n");
+         AppendTo(filename,line,"\n");
+      od;
+   od;
+od;
+return results;
+end;
+
+TransversalPropertiesBenchmarkInputs := function(cases,dirname)
+#
+# Writes to the directory  dirname  (made if need be) the standalone 
+# inputs for  tpexternal,  made by  PrintStreamTpexternalInput,  for the tests
+# of the orbit reps done by  UniversalTransversalProperty  in the
+# k-ut cases in the list  cases.  The input for the  j-th  rep of
+# the case named  name  is put in the file  name_kk_j.txt  (with the
+# parentheses and commas in  name  replaced by underscores), or in 
+# name_kk_j.tpb  if it is in the binary format (that is, if 
+# TRANSVERSALPROPERTIES_tpexternal_binary=true),  and the 
+# command-line arguments for it in  name_kk_j.args.
+#
+local dir,case,G,k,setup,j,base,ext,stream,args,saved,x;
+if not IsDirectoryPath(dirname) then
+   CreateDir(dirname);
+fi;
+dir:=Directory(dirname);
+# the arguments are to be those for the search alone
+saved:=TRANSVERSALPROPERTIES_tpexternal_progress;
+TRANSVERSALPROPERTIES_tpexternal_progress:=0;
+if TRANSVERSALPROPERTIES_tpexternal_binary then
+   ext:=".tpb";
+else
+   ext:=".txt";
+fi;
+for case in cases do
+   G:=case.group();
+   for k in case.ut do
+      setup:=UniversalTransversalPropertySetup(G,k,G,LeastSetRepresentatives);
+      if IsBool(setup) then
+         continue; # there is nothing for tpexternal to do
+      fi;
+      # the inputs are to be standalone, so no group cache file is used
+      args:=TpexternalArgs(G,Length(setup.shortreps));
+      for x in ["-g","-G"] do
+         if x in args then
+            args:=Concatenation(args{[1..Position(args,x)-1]},
+               args{[Position(args,x)+2..Length(args)]});
+         fi;
+      od;
+      args:=Filtered(args,x->x<>"-v");
+      for j in [1..Length(setup.reps)] do
+         base:=Concatenation(ReplacedString(ReplacedString(ReplacedString(
+            case.name,"(","_"),")","_"),",","_"),"_k",String(k),"_",String(j));
+         stream:=OutputTextFile(Filename(dir,Concatenation(base,ext)),
+            false);
+         SetPrintFormattingStatus(stream,false);
+         PrintStreamTpexternalInput(stream,G,k,OrbAdjacency(G,setup.reps[j]),
+            setup.shortreps);
+         CloseStream(stream);
+         PrintTo(Filename(dir,Concatenation(base,".args")),
+            JoinStringsWithSeparator(args," "),"\n");
+      od;
+   od;
+od;
+TRANSVERSALPROPERTIES_tpexternal_progress:=saved;
+end;
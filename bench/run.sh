@@ -0,0 +1,40 @@
+#!/bin/sh
+#
+# Times tpexternal on the standalone inputs made by the GAP function
+# TransversalPropertiesBenchmarkInputs (see bench/benchmark.g).
+#
+# usage: bench/run.sh tpexternal [inputdir [extra tpexternal options]]
+#
+# For each input file name_kk_j.txt (or name_kk_j.tpb, in the binary
+# format) in inputdir (default bench/inputs), tpexternal is run with
+# the arguments in name_kk_j.args, the extra options given and -v, and
+# a line is written to the standard output giving: the input name, the
+# result, and the search time in seconds, nodes searched and peak
+# memory in kilobytes reported by tpexternal.
+
+if [ $# -lt 1 ]; then
+   echo "usage: $0 tpexternal [inputdir [extra tpexternal options]]" >&2
+   exit 1
+fi
+exe=$1
+dir=${2:-bench/inputs}
+[ $# -ge 2 ] && shift
+shift
+
+for input in "$dir"/*.txt "$dir"/*.tpb; do
+   [ -e "$input" ] || continue
+   name=$(basename "$input")
+   name=${name%.*}
+   args=$(cat "$dir/$name.args")
+   # shellcheck disable=SC2086
+   output=$("$exe" $args "$@" -v < "$input") || {
+      echo "$name failed" >&2
+      continue
+   }
+   result=$(echo "$output" | head -n 1 | cut -d ' ' -f 1)
+   stats=$(echo "$output" | sed -n 2p)
+   seconds=$(echo "$stats" | sed 's/.*seconds:=\([^,]*\),.*/\1/')
+   nodes=$(echo "$stats" | sed 's/^rec(nodes:=\([^,]*\),.*/\1/')
+   maxrsskb=$(echo "$stats" | sed 's/.*maxrsskb:=\([^,]*\),.*/\1/')
+   echo "$name $result $seconds $nodes $maxrsskb"
+done
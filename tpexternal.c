@@ -1,7 +1,102 @@
 /* This program includes a C version of my GAP function
    TransversalProperty, which is applied for a given G-orbit of
-   k-subsets of {1,...,n} (encoded by adj and cosetreps for G assumed
-   to be transitive on {1,...,n}) and a given sequence of shortreps.
+   k-subsets of {1,...,n} (encoded by adj and cosetreps for G 
+   transitive on {1,...,n}) and a given sequence of shortreps. With 
+   the option -i, G need not be transitive, and the input then also 
+   gives the least point in the G-orbit of each point, and an adj 
+   for each of these orbit reps (see main below).
+
+   The program reads its input from the standard input, and writes 1
+   (true) or 0 (false) to the standard output. With the option 
+   -t nthreads, the search trees for the shortreps are searched by 
+   nthreads threads in parallel (-t 0 uses all the available processors). 
+   With the option -m tablemb, the table of the images under the coset 
+   reps of the (k-1)-subsets in the adjacency is precomputed only if 
+   it needs at most tablemb megabytes (-m 0 never makes this table).
+
+   With the option -s (server mode), the group data n, k and the coset
+   reps are read in once, followed by a stream of jobs, each consisting 
+   of an adjacency and its shortreps (in the same format as for a 
+   single run). The result for each job is written (and flushed) as 
+   soon as it is known, and the program ends at the end of its input, 
+   or when it reads a negative length in place of an adjacency.
+
+   With the option -S (strong mode), the program instead decides the
+   strong transversal property for a given G-orbit of tuples [T,U]
+   (see StrongTransversalProperty below). The input then consists 
+   of n and k, followed (for each job) by the tuples of the orbit, each 
+   as the list T[1],T[2],U[1],...,U[k-1], ending with a list of length 
+   0, and then the shortreps. The search in strong mode is sequential, 
+   so that the options -t and -m have no effect on it (nor do the 
+   options -v and -p below).
+
+   With the option -d, each adj is followed by a list giving, for each
+   k-subset K in the orbit defined by adj, the indices of the shortreps 
+   in the G-orbits of the (k-1)-subsets of K (see orbitdata below), 
+   so that the search for a shortrep can be cut short on meeting a 
+   (k-1)-subset in the G-orbit of a shortrep whose search has been 
+   completed (as is done in my GAP function TransversalProperty).
+
+   The input may be given either as text or in a binary format (see 
+   ReadInput below), which is recognised automatically.
+
+   With the option -c file (for a single sequential search, so not 
+   with -s, -S or -t), the state of the search is saved in the given 
+   checkpoint file every -C seconds (default DEFAULT_CHECKPOINT_SECONDS),
+   and also when the program is sent SIGTERM or SIGINT (after which 
+   it exits). If the checkpoint file exists when the program starts, 
+   the search is resumed from the state saved in it, so the program
+   must then be given the same input as before. The checkpoint file
+   is removed when the search is finished (see checkpoint below).
+
+   With the option -w, a result 0 is followed (on the same line) by the
+   parts A[1],...,A[n] of the points in a counterexample, that is, a 
+   k-partition of {1,...,n}, with P[k] of size at least n/k, of which 
+   no k-subset in the G-orbit is a transversal (A[i]==j meaning that 
+   i is in P[j]). This option has no effect in strong mode.
+
+   With the options -b branch (first, last or cover) and -o partorder 
+   (up, down, small or large), the strategies for choosing the point on which
+   the search branches, and the order in which its parts are tried, 
+   can be set (see branchstrategy below). These have no effect in 
+   strong mode.
+
+   With the option -y, the shortreps of each job are followed, for 
+   each shortrep in turn, by a list of elements of G (in image form, 
+   as integer lists of length n) fixing each point of the shortrep, 
+   ending with a list of length 0. These are used to prune the search
+   tree of the shortrep (see SymmetryPrune below). This option has no 
+   effect in strong mode.
+
+   With the option -e engine (scan, count or scalar), the engine for 
+   testing the k-subsets through each new point of a partition can be 
+   set (see ExtendRCount below). The count engine is only used if its 
+   tables fit in tablemb megabytes (and k<=65), and the scalar engine 
+   is the scan engine without its vectorised kernel (see ExtendR below).
+   The search (but not the time taken) is the same for all of these. 
+   This option has no effect in strong mode.
+
+   With the option -G file, the group data read in are also saved in 
+   the given group cache file, and with the option -g file, they are 
+   instead taken from such a file, which is shared by the runs using it
+   (see GroupCacheMap below). These options have no effect in strong 
+   mode.
+
+   With the option -v, the result for each job is followed by a line
+   giving the statistics of its search (see searchstats below), in 
+   the form of a GAP record, 
+     rec(nodes:=...,maxdepth:=...,adjscanned:=...,hits:=...,
+         cutoffs:=...,doneprunes:=...,symprunes:=...,seconds:=...,
+         maxrsskb:=...,shortrepnodes:=[...])
+   where seconds is the (wall-clock) time taken by the search, maxrsskb
+   is the peak memory (resident set size, in kilobytes) used so far by 
+   the program, and shortrepnodes lists the nodes searched for each 
+   shortrep.
+
+   With the option -p seconds, a progress report for the search is 
+   written to the standard error (about) every given number of seconds.
+
+   To compile:  cc -O2 -pthread -o tpexternal tpexternal.c 
 
    Leonard Soicher, 30/03/2026 */
 
@@ -9,6 +104,21 @@
 #include <stddef.h>
 #include <stdio.h>
 #include <stdbool.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <limits.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <signal.h>
+#include <time.h>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define HAVE_AVX2_KERNEL /* see TransversalMask8 below */
+#endif
 
 /* Integer lists are stored in 1-dimensional arrays, 
    with indexing starting at 1.
@@ -41,13 +151,143 @@ SetLength(L,length);
 return L;
 }
 
+/* The input is read from the standard input, either as text (integers 
+   separated by white space), or, if the input starts with the four 
+   bytes BINARY_MAGIC, in binary. In the binary format, the integers 
+   are the same as in the text format, and in the same order, but 
+   each is given by 4 bytes, in little-endian two's complement form, 
+   except that the ranks of (k-1)-subsets in the adjacencies (which
+   can exceed INT_MAX for large n) are each given by 8 bytes (see 
+   ReadRank). A binary input is read in all at once by ReadInput. */
+
+#define BINARY_MAGIC "TPB1"
+
+unsigned char *binaryinput; /* the binary input (or NULL for text input) */
+size_t binarylength,binarypos; /* its length, and the current position */
+
+void ReadInput()
+/* Determines the format of the input, and if this is binary,
+   reads in all the input (after BINARY_MAGIC) into binaryinput. */
+{
+int c;
+size_t capacity,got;
+struct stat st;
+binaryinput=NULL;
+c=getc(stdin);
+if(c==EOF)
+   return;
+if(c!=BINARY_MAGIC[0])
+   {
+   /* text input */
+   ungetc(c,stdin);
+   return;
+   }
+if(getc(stdin)!=BINARY_MAGIC[1] || getc(stdin)!=BINARY_MAGIC[2] 
+   || getc(stdin)!=BINARY_MAGIC[3])
+   {
+   fprintf(stderr,"\nReadInput error: bad binary input header\n");
+   exit(EXIT_FAILURE);
+   }
+/* when the input is a regular file, a single fread suffices */
+if(fstat(fileno(stdin),&st)==0 && S_ISREG(st.st_mode) && st.st_size>4)
+   capacity=(size_t)st.st_size;
+else
+   capacity=1<<20;
+binarylength=0;
+binarypos=0;
+for(;;)
+   {
+   if((binaryinput=(unsigned char *)realloc(binaryinput,capacity))==NULL)
+      {
+      fprintf(stderr,"\nReadInput error: realloc failed\n");
+      exit(EXIT_FAILURE);
+      }
+   got=fread(binaryinput+binarylength,1,capacity-binarylength,stdin);
+   binarylength+=got;
+   if(binarylength<capacity)
+      break; /* the end of the input has been reached */
+   capacity*=2;
+   }
+}
+
+bool ReadInt(int *x)
+/* Reads in the next integer of the input into *x, and returns true, 
+   or returns false if there are no more integers in the input. */
+{
+unsigned int u;
+if(binaryinput==NULL)
+   return scanf("%d",x)==1;
+if(binarypos+4>binarylength)
+   return false;
+u=(unsigned int)binaryinput[binarypos]
+  | ((unsigned int)binaryinput[binarypos+1]<<8)
+  | ((unsigned int)binaryinput[binarypos+2]<<16)
+  | ((unsigned int)binaryinput[binarypos+3]<<24);
+binarypos+=4;
+*x=(u<=INT_MAX) ? (int)u : -(int)(~u)-1;
+return true;
+}
+
+bool ReadRank(long long *x)
+/* Reads in the next rank of a (k-1)-subset of the input into *x, and 
+   returns true, or returns false if there are no more integers in the 
+   input. */
+{
+unsigned long long u;
+int i;
+if(binaryinput==NULL)
+   return scanf("%lld",x)==1;
+if(binarypos+8>binarylength)
+   return false;
+u=0;
+for(i=7;i>=0;i--)
+   u=(u<<8)|binaryinput[binarypos+i];
+binarypos+=8;
+*x=(u<=LLONG_MAX) ? (long long)u : -(long long)(~u)-1;
+return true;
+}
+
+long long *RankListReadOrEnd(bool orend)
+/* Reads in and returns a new list of ranks (with its length in entry 0)
+   from the standard input, as for IntListRead, except that if orend is
+   true then NULL is returned if the end of the standard input is 
+   reached, or a negative length is read in, instead of a list length. */
+{
+int i,length;
+long long *L;
+if(!ReadInt(&length) || length<0)
+   {
+   if(orend)
+      return NULL;
+   fprintf(stderr,"\nRankListReadOrEnd error: bad list length\n");
+   exit(EXIT_FAILURE);
+   }
+if((L=(long long *)malloc(((size_t)length+1)*sizeof(long long)))==NULL)
+   {
+   fprintf(stderr,"\nRankListReadOrEnd error: malloc failed\n");
+   exit(EXIT_FAILURE);
+   }
+L[0]=length;
+for(i=1;i<=length;i++)
+   if(!ReadRank(&L[i]))
+      {
+      fprintf(stderr,"\nRankListReadOrEnd error: unexpected end of input\n");
+      exit(EXIT_FAILURE);
+      }
+return L;
+}
+
 intlist IntListRead() 
 /* Reads in and returns a new integer list from the standard input.
    First the length is read in, followed by the list elements (in order). */
 {
 int i,length;
 intlist L;
-scanf("%d",&length);
+if(!ReadInt(&length))
+   {
+   fprintf(stderr,"\nIntListRead error: unexpected end of input\n");
+   exit(EXIT_FAILURE);
+   }
 if(length<0)
    {
    fprintf(stderr,"\nIntListRead error: negative length given for a list\n");
@@ -55,262 +295,3059 @@ if(length<0)
    }
 L=IntList(length);
 for(i=1;i<=length;i++)
-   scanf("%d",&L[i]);
+   ReadInt(&L[i]);
 return L;
 }
 
-int Binomial(int n,int k)
-/* where n>=k>=0, returns the number of k-subsets of an n-set */
+void IntListReadInto(intlist L,int length) 
+/* Reads in an integer list of the given length from the standard input,
+   storing it in L (which must have room for it). The length is read in 
+   first, followed by the list elements (in order). */
 {
-if(n<k || k<0)
+int i,len;
+if(!ReadInt(&len) || len!=length)
    {
-   fprintf(stderr,"\nBinomial error: n<k or k<0\n");
+   fprintf(stderr,"\nIntListReadInto error: list of unexpected length\n");
+   exit(EXIT_FAILURE);
+   }
+SetLength(L,length);
+for(i=1;i<=length;i++)
+   ReadInt(&L[i]);
+}
+
+/* A table of integer lists, all of the same length, is stored in a
+   single (contiguous) array, with its lists one after the other, 
+   so that the i-th list (i>=1) of a table T of lists of length len
+   is the integer list TableRow(T,len,i), with its length len stored 
+   in entry 0 as usual. */
+
+typedef int* intlisttable;
+
+#define TableRow(T,len,i) ((T)+((size_t)(i))*((size_t)((len)+1)))
+
+intlisttable IntListTable(int numlists,int length)
+/* returns a new table of numlists uninitialized integer lists of 
+   the given length */
+{
+intlisttable T;
+int i;
+if(numlists<0 || length<0)
+   {
+   fprintf(stderr,"\nIntListTable error: negative size given for a table\n");
+   exit(EXIT_FAILURE);
+   }
+if((T=(intlisttable)malloc(((size_t)(numlists+1))*((size_t)(length+1))*
+                           sizeof(int)))==NULL)
+   {
+   fprintf(stderr,"\nIntListTable error: malloc failed\n"); 
+   exit(EXIT_FAILURE);
+   }
+for(i=1;i<=numlists;i++)
+   SetLength(TableRow(T,length,i),length);
+return T;
+}
+
+/* Subsets of {1,...,n} are stored as bitsets, that is, arrays of 
+   BitsetWords(n) words, such that i is in the subset represented by 
+   the bitset b if and only if bit i%WORDBITS of b[i/WORDBITS] is set. */
+
+typedef unsigned long long bitword;
+
+typedef bitword* bitset;
+
+#define WORDBITS (8*(int)sizeof(bitword))
+
+#define BitsetWords(n) ((n)/WORDBITS+1) /* for subsets of {1,...,n} */
+
+#define IsBitsetMember(b,i) ((((b)[(i)/WORDBITS])>>((i)%WORDBITS))&1)
+
+#define AddBitsetMember(b,i) \
+   (((b)[(i)/WORDBITS])|=((bitword)1)<<((i)%WORDBITS))
+
+#define RemoveBitsetMember(b,i) \
+   (((b)[(i)/WORDBITS])&=~(((bitword)1)<<((i)%WORDBITS)))
+
+#if defined(__GNUC__)
+#define TrailingZeros(w) __builtin_ctzll(w)
+#define LeadingZeros(w) __builtin_clzll(w)
+#else
+int TrailingZeros(bitword w)
+/* where w!=0, returns the number of trailing zero bits of w */
+{
+int z;
+for(z=0;!(w&1);z++)
+   w>>=1;
+return z;
+}
+
+int LeadingZeros(bitword w)
+/* where w!=0, returns the number of leading zero bits of w */
+{
+int z;
+for(z=0;!(w>>(WORDBITS-1));z++)
+   w<<=1;
+return z;
+}
+#endif
+
+bitset Bitset(int n) 
+/* returns a new bitset representing the empty subset of {1,...,n} */
+{
+bitset b;
+if((b=(bitset)calloc((size_t)BitsetWords(n),sizeof(bitword)))==NULL)
+   {
+   fprintf(stderr,"\nBitset error: calloc failed\n");
    exit(EXIT_FAILURE);
    }
-if(k==0)
-   return 1;
-return (Binomial(n-1,k-1)*n)/k;
+return b;
+}
+
+int BitsetFirst(bitset b,int nwords)
+/* returns the least element of the subset represented by the bitset b
+   of nwords words, or 0 if this subset is empty */
+{
+int i;
+for(i=0;i<nwords;i++)
+   if(b[i]!=0)
+      return i*WORDBITS+TrailingZeros(b[i]);
+return 0;
+}
+
+int BitsetLast(bitset b,int nwords)
+/* returns the greatest element of the subset represented by the bitset b
+   of nwords words, or 0 if this subset is empty */
+{
+int i;
+for(i=nwords-1;i>=0;i--)
+   if(b[i]!=0)
+      return i*WORDBITS+WORDBITS-1-LeadingZeros(b[i]);
+return 0;
 }
 
-intlist *Combinations(int n,int k)
-/* where n>=k>=0, returns an list in lex-order (indexed starting at 1), 
-   of the k-subsets of {1,...,n} (given as lists of integers
-   in increasing order) */ 
+long long Binomial(int n,int k)
+/* where n>=k>=0, returns the number of k-subsets of an n-set, 
+   or LLONG_MAX if this number is at least LLONG_MAX */
 {
-int i,j,jj,binom;
-intlist *comb;
+int i;
+long long b;
 if(n<k || k<0)
    {
-   fprintf(stderr,"\nCombinations error: n<k or k<0\n"); 
+   fprintf(stderr,"\nBinomial error: n<k or k<0\n");
    exit(EXIT_FAILURE);
    }
-binom=Binomial(n,k);
-if((comb=(intlist *)malloc(((unsigned)(binom+1))*sizeof(intlist)))==NULL)
+if(k>n-k)
+   k=n-k;
+b=1;
+for(i=0;i<k;i++)
+   {
+   /* here b is the number of i-subsets of an n-set */
+   if(b>LLONG_MAX/(n-i))
+      return LLONG_MAX;
+   b=(b*(n-i))/(i+1);
+   }
+return b;
+}
+
+void CombinationUnrank(int n,int k,long long rank,intlist c)
+/* where n>=k>=0, sets c to be the rank-th (counting from 1) k-subset
+   of {1,...,n} (as a list of integers in increasing order) in the 
+   lex-order of these k-subsets, without making the k-subsets 
+   preceding it */ 
+{
+int j,x;
+long long r,count;
+if(n<k || k<0 || rank<1 || rank>Binomial(n,k))
    {
-   fprintf(stderr,"\nCombinations error: malloc failed\n"); 
+   fprintf(stderr,"\nCombinationUnrank error: bad n, k or rank\n"); 
    exit(EXIT_FAILURE);
    }
-/* make the first combination */
-comb[1]=IntList(k);
+SetLength(c,k);
+r=rank-1; /* the number of k-subsets preceding c */
+x=1;
 for(j=1;j<=k;j++)
-   comb[1][j]=j;
-for(i=2;i<=binom;i++)
-   /* make the i-th combination */
    {
-   comb[i]=IntList(k);
-   for(j=k;j>=1;j--)
+   /* the k-subsets with the first j-1 elements c[1],...,c[j-1] and 
+      j-th element x number Binomial(n-x,k-j), and if they all precede 
+      c then we skip over them */
+   while((count=Binomial(n-x,k-j))<=r)
       {
-      if(comb[i-1][j]<n-(k-j))
-         {
-         for(jj=1;jj<j;jj++)
-            comb[i][jj]=comb[i-1][jj];
-         comb[i][j]=comb[i-1][j]+1;
-         for(jj=j+1;jj<=k;jj++)
-            comb[i][jj]=comb[i][jj-1]+1;
-         break;
-         }   
-      }         
+      r-=count;
+      x++;
+      }
+   c[j]=x;
+   x++;
    }
-return comb;
 }
 
-bool TransversalProperty(int n,int k,intlist *cosetreps,intlist adj,
-                         intlist *comb,intlist A,bool *R,int newpoint)
-/* Let (cosetreps,adj) represent a G-orbit of k-subsets of {1,...,n}, 
-   where G is a transitive group on {1,...,n} and k>1. Thus, the 
-   (k-1)-subsets extending i (in {1,...,n}) to a k-subset in the 
-   represented G-orbit are those indexed in comb by the images 
-   of the elements of adj under cosetreps[i].
-
-   Let A represent an ordered k-partition [P[1],...,P[k]]
-   of {1,...,n}, where A is an integer list of length n,
-   such that A[i]==j means that i is in the j-th part P[j] of P.
-
-   Let R represent a subset S of {1,...,n}, where R is a
-   boolean list such that, for i=1,...,n, R[i]==true if
-   i is in the subset S and R[i]==false if i is not in S.
-   It is required that A[s]==k for all s in S (i.e. R represents 
-   a subset contained in P[k]).
+/* The G-orbit of k-subsets under consideration is given by the 
+   orbitdata below. For i in {1,...,n}, let o=orbitrep[i] be the least
+   point in the G-orbit of i. Then the (k-1)-subsets extending i to 
+   a k-subset in the G-orbit of k-subsets are the images under the coset 
+   rep TableRow(cosetreps,n,i) (which maps o to i) of the (k-1)-subsets 
+   extending o, which are the ones in the rows adjfirst[o]+1,...,
+   adjfirst[o]+numadjof[o] of adjcomb. When G is transitive, o is always 1. 
+   The images are stored one after the other, so that scanning them 
+   runs sequentially through memory. */
 
-   Let newpoint be an element of {1,...,n} such that A[newpoint] < k
-   (i.e newpoint is in one of P[1],...,P[k-1]).
+typedef struct
+   {
+   int n,k;
+   intlisttable cosetreps; /* for i=1,...,n, TableRow(cosetreps,n,i) is 
+                              an element of G (in image form) mapping 
+                              orbitrep[i] to i */
+   intlist orbitrep; /* orbitrep[i] is the least point in the G-orbit 
+                        of i */
+   int numadj; /* the number of (k-1)-subsets in adjcomb */
+   intlisttable adjcomb; /* for each orbit rep o, and j=1,...,numadjof[o], 
+                            TableRow(adjcomb,k-1,adjfirst[o]+j) is the 
+                            (k-1)-subset (in increasing order) indexed by 
+                            the j-th element of the adjacency of vertex o 
+                            in orbgraph */
+   int *numadjof,*adjfirst; /* for i=1,...,n, numadjof[i] and adjfirst[i] 
+                               are numadjof[o] and adjfirst[o] as above, 
+                               for o=orbitrep[i] */
+   size_t *imagefirst; /* imagefirst[i] is the sum of numadjof[j] for 
+                          j=1,...,i-1 */
+   size_t numimages; /* the sum of numadjof[i] for i=1,...,n */
+   intlisttable adjshortrep; /* if not NULL, then for the row 
+                                adjfirst[o]+j of adjcomb (holding c, 
+                                say), with K the union of c and {o}, 
+                                TableRow(adjshortrep,k,adjfirst[o]+j) 
+                                is the list of the indices (from 1) in 
+                                the list of shortreps of the job of the 
+                                shortreps in the G-orbits of K minus o,
+                                K minus c[1],...,K minus c[k-1] (where 
+                                the index 0 is used for a G-orbit not 
+                                containing any shortrep of the job) */
+   atomic_bool *done; /* if adjshortrep is not NULL, then done[s] is 
+                         true iff the search for the s-th shortrep has 
+                         been completed (and found no counterexample),
+                         and done[0] is false */
+   atomic_int numdone; /* the number of s with done[s] true */
+   intlisttable images; /* if not NULL, then for i=1,...,n and 
+                           j=1,...,numadjof[i], 
+                           TableRow(images,k-1,imagefirst[i]+j) is the
+                           image of TableRow(adjcomb,k-1,adjfirst[i]+j) 
+                           under the i-th coset rep, sorted into 
+                           increasing order (so that the lookups of its 
+                           points in a partition move forward through 
+                           memory) */
+   intlisttable *sym; /* if not NULL (option -y), then for the s-th 
+                         shortrep of the job (s from 1), the rows of 
+                         sym[s] (of length n) are numsym[s] elements of 
+                         G (in image form) fixing each point of that 
+                         shortrep */
+   int *numsym;
+   int numksets; /* if kset is not NULL (see ExtendRCount below), the 
+                    number of k-subsets in orb, which are numbered 
+                    1,...,numksets */
+   int *kset; /* if not NULL, then for i=1,...,n and j=1,...,numadjof[i],
+                 kset[imagefirst[i]+j] is the number of the union of 
+                 {i} and the cosetrep-image of 
+                 TableRow(adjcomb,k-1,adjfirst[i]+j) */
+   int *ksetsum; /* if kset is not NULL, then ksetsum[K] is the sum of
+                    the points in the K-th k-subset */
+   } orbitdata;
 
-   Furthermore, suppose that |P[1]|+...+|P[k-1]|<=((k-1)*n)/k, and 
-   for every k-subset K in orb not containing newpoint,
-   if the intersection of K with each of P[1],...,P[k-1]
-   has size 1, then the remaining point of K is in the subset S
-   represented by R.
-   
-   Then this boolean function returns true if for every k-partition Q of
-   {1,...,n} satisfying:
-     - Q[i] contains P[i] for i=1,...,k-1,
-     - no element of S (represented by R) is in Q[k],
-     - |Q[k]| >= n/k,
-   there is a k-set in orb forming a transversal of Q.
- 
-   Otherwise, this function returns false. */
+void MakeImages(orbitdata *od)
+/* makes the table od->images, of od->numimages*(k-1) points */
 {
-bool injective,tp;
-bool *Rnew;
-bool *covered;
-int Acount,Rnewcount,i,j,kpoint,r,part;
-intlist cosetrep;
-intlist c;
-if((Rnew=(bool *)malloc(((unsigned)(n+1))*sizeof(bool)))==NULL)
+int n,k,i,j,jj,x,pos;
+intlist cosetrep,c,image;
+n=od->n;
+k=od->k;
+od->images=IntListTable((int)od->numimages,k-1);
+for(i=1;i<=n;i++)
    {
-   fprintf(stderr,"\nTransversalProperty error: malloc failed\n"); 
-   exit(EXIT_FAILURE);
+   cosetrep=TableRow(od->cosetreps,n,i);
+   for(j=1;j<=od->numadjof[i];j++)
+      {
+      c=TableRow(od->adjcomb,k-1,od->adjfirst[i]+j);
+      image=TableRow(od->images,k-1,od->imagefirst[i]+j);
+      /* insertion sort of the image of c */
+      for(jj=1;jj<=k-1;jj++)
+         {
+         x=cosetrep[c[jj]];
+         for(pos=jj;pos>1 && image[pos-1]>x;pos--)
+            image[pos]=image[pos-1];
+         image[pos]=x;
+         }
+      }
    }
-if((covered=(bool *)malloc(((unsigned)(k+1))*sizeof(bool)))==NULL)
+}
+
+bool MakeKsets(orbitdata *od,double tablemb)
+/* numbers the k-subsets in orb, making od->numksets, od->kset and 
+   od->ksetsum (using a hash table of these k-subsets, as sorted lists), 
+   if these (and the hash table) need at most tablemb megabytes, and 
+   returns true, and otherwise returns false (with od->kset NULL) */
+{
+int n,k,i,j,jj,x,pos,maxksets,numksets,K;
+size_t size,h;
+intlist cosetrep,c,image;
+intlisttable ksets;
+int *table;
+n=od->n;
+k=od->k;
+od->kset=NULL;
+if(od->numimages%k!=0 || od->numimages/k>(size_t)INT_MAX/4
+   || ((double)od->numimages+(double)(od->numimages/k)*(k+6))*sizeof(int)
+      >tablemb*1048576.0)
+   return false;
+maxksets=(int)(od->numimages/k); /* each k-subset is through k points */
+for(size=1;size<2*(size_t)maxksets;size*=2)
+   ;
+if((od->kset=(int *)malloc((od->numimages+1)*sizeof(int)))==NULL
+   || (table=(int *)calloc(size,sizeof(int)))==NULL)
    {
-   fprintf(stderr,"\nTransversalProperty error: malloc failed\n"); 
+   fprintf(stderr,"\nMakeKsets error: malloc failed\n"); 
    exit(EXIT_FAILURE);
    }
-Acount=0;
-Rnewcount=0;
+ksets=IntListTable(maxksets+1,k); /* the last row is for the new one */
+numksets=0;
 for(i=1;i<=n;i++)
    {
-   if(A[i]<k)
-      Acount++;
-   Rnew[i]=R[i];
-   if(Rnew[i])
-      Rnewcount++;
-   }
-cosetrep=cosetreps[newpoint]; /* an element of G (in image form) 
-                                 mapping 1 to newpoint */
-for(i=1;i<=Length(adj);i++)
-   {
-   c=comb[adj[i]];
-   /* first, determine if the values of A (the parts) indexed by
-      newpoint and the points in the cosetrep-image of c are
-      all of {1,...,k}, and if so, set kpoint to be that point in 
-      this image with A[kpoint]==k  */
-   injective=true;  /* initially */
-   for(j=1;j<=k;j++)
-      covered[j]=false;
-   covered[A[newpoint]]=true;
-   if(A[newpoint]==k)
-      kpoint=newpoint;
-   for(j=1;j<=k-1;j++)
+   cosetrep=TableRow(od->cosetreps,n,i);
+   for(j=1;j<=od->numadjof[i];j++)
       {
-      part=A[cosetrep[c[j]]];
-      if(covered[part])
+      /* put the k-subset, sorted, in the last row of ksets */
+      c=TableRow(od->adjcomb,k-1,od->adjfirst[i]+j);
+      image=TableRow(ksets,k,maxksets+1);
+      image[1]=i;
+      for(jj=1;jj<=k-1;jj++)
          {
-         /* part is covered twice */
-         injective=false;
-         break;
+         x=cosetrep[c[jj]];
+         for(pos=jj+1;pos>1 && image[pos-1]>x;pos--)
+            image[pos]=image[pos-1];
+         image[pos]=x;
          }
-      else
+      h=0;
+      for(jj=1;jj<=k;jj++)
+         h=h*31+(size_t)image[jj];
+      for(h&=size-1;(K=table[h])!=0;h=(h+1)&(size-1))
+         if(memcmp(TableRow(ksets,k,K)+1,image+1,((size_t)k)*sizeof(int))==0)
+            break;
+      if(K==0)
          {
-         covered[part]=true;
-         if(part==k)
-            kpoint=cosetrep[c[j]];
+         if(numksets==maxksets)
+            {
+            fprintf(stderr,"\nMakeKsets error: inconsistent adjacencies\n");
+            exit(EXIT_FAILURE);
+            }
+         K=table[h]=++numksets;
+         memcpy(TableRow(ksets,k,K)+1,image+1,((size_t)k)*sizeof(int));
          }
+      od->kset[od->imagefirst[i]+j]=K;
       }
-   if(injective)
+   }
+od->numksets=numksets;
+if((od->ksetsum=(int *)malloc(((size_t)(numksets+1))*sizeof(int)))==NULL)
+   {
+   fprintf(stderr,"\nMakeKsets error: malloc failed\n"); 
+   exit(EXIT_FAILURE);
+   }
+for(K=1;K<=numksets;K++)
+   {
+   image=TableRow(ksets,k,K);
+   od->ksetsum[K]=0;
+   for(jj=1;jj<=k;jj++)
+      od->ksetsum[K]+=image[jj];
+   }
+free(ksets);
+free(table);
+return true;
+}
+
+bool AdjacenciesRead(orbitdata *od,bool server,bool withshortreps)
+/* Reads in the adjacencies of the orbit reps o (with od->orbitrep[o]==o), 
+   in increasing order of o, as lists of indices in the lex-ordered list 
+   (indexed from 1) of the (k-1)-subsets of {1,...n}, and sets up 
+   od->numadj, od->adjcomb, od->numadjof, od->adjfirst, od->imagefirst 
+   and od->numimages from these. If withshortreps is true, then each 
+   adjacency is followed by the list of length k times its length, 
+   giving the rows of od->adjshortrep for it, one after the other, 
+   and otherwise od->adjshortrep is set to NULL. In server mode, the 
+   function returns false if the end of the input or a negative length 
+   is read in place of the first adjacency, and otherwise it returns 
+   true. */
+{
+int n,k,o,i,j;
+long long **adj;
+intlist *adjsr;
+n=od->n;
+k=od->k;
+if((adj=(long long **)calloc((size_t)(n+1),sizeof(long long *)))==NULL
+   || (adjsr=(intlist *)calloc((size_t)(n+1),sizeof(intlist)))==NULL
+   || (od->numadjof=(int *)malloc(((size_t)(n+1))*sizeof(int)))==NULL
+   || (od->adjfirst=(int *)malloc(((size_t)(n+1))*sizeof(int)))==NULL
+   || (od->imagefirst=(size_t *)malloc(((size_t)(n+1))*sizeof(size_t)))
+      ==NULL)
+   {
+   fprintf(stderr,"\nAdjacenciesRead error: malloc failed\n"); 
+   exit(EXIT_FAILURE);
+   }
+od->numadj=0;
+for(o=1;o<=n;o++)
+   if(od->orbitrep[o]==o)
       {
-      /* is kpoint in the set represented by Rnew? */
-      if(!Rnew[kpoint])
+      if(server && o==1)
          {
-         Rnew[kpoint]=true;
-         Rnewcount++;
-         if((Acount+Rnewcount)*k>(k-1)*n)
+         if((adj[o]=RankListReadOrEnd(true))==NULL)
             {
-            free(covered);
-            free(Rnew);
-            return true;
+            free(adj);
+            free(adjsr);
+            free(od->numadjof);
+            free(od->adjfirst);
+            free(od->imagefirst);
+            return false;
             }
          }
+      else
+         adj[o]=RankListReadOrEnd(false);
+      if(withshortreps)
+         {
+         if((double)Length(adj[o])*k>(double)INT_MAX)
+            {
+            fprintf(stderr,"\nAdjacenciesRead error: adjacency too long\n");
+            exit(EXIT_FAILURE);
+            }
+         adjsr[o]=IntList(Length(adj[o])*k);
+         IntListReadInto(adjsr[o],Length(adj[o])*k);
+         }
+      od->adjfirst[o]=od->numadj;
+      od->numadjof[o]=Length(adj[o]);
+      if(Length(adj[o])>INT_MAX-od->numadj)
+         {
+         fprintf(stderr,"\nAdjacenciesRead error: too many (k-1)-subsets\n");
+         exit(EXIT_FAILURE);
+         }
+      od->numadj+=Length(adj[o]);
       }
-   }
-if(Rnewcount==0)
-   {
-   free(covered);
-   free(Rnew);
-   return false;
-   }
+od->adjcomb=IntListTable(od->numadj,k-1);
+od->adjshortrep=(withshortreps ? IntListTable(od->numadj,k) : NULL);
+od->numimages=0;
 for(i=1;i<=n;i++)
-   if(Rnew[i])
+   {
+   o=od->orbitrep[i];
+   if(o==i)
       {
-      r=i;
-      /* remove r from the set represented by Rnew */
-      Rnew[r]=false;
-      Rnewcount--;
-      break;
+      for(j=1;j<=Length(adj[o]);j++)
+         CombinationUnrank(n,k-1,adj[o][j],
+                           TableRow(od->adjcomb,k-1,od->adjfirst[o]+j));
+      free(adj[o]);
+      if(withshortreps)
+         {
+         for(j=1;j<=Length(adjsr[o]);j++)
+            TableRow(od->adjshortrep,k,od->adjfirst[o]+(j-1)/k+1)[(j-1)%k+1]
+               =adjsr[o][j];
+         free(adjsr[o]);
+         }
       }
-/* now try putting r in each of the first k-1 parts of the 
-   ordered partition represented by A */
-for(i=1;i<=k-1;i++)
+   od->adjfirst[i]=od->adjfirst[o];
+   od->numadjof[i]=od->numadjof[o];
+   od->imagefirst[i]=od->numimages;
+   od->numimages+=od->numadjof[i];
+   }
+free(adj);
+free(adjsr);
+return true;
+}
+
+static inline bool IsTransversal(int k,intlist A,int newpoint,intlist c,
+                                 intlist cosetrep,bool *covered,int *kpoint)
+/* Determines if the values of A (the parts) indexed by newpoint and 
+   the points in the cosetrep-image of the (k-1)-subset c are all of 
+   {1,...,k}, and if so, sets *kpoint to be that point among these 
+   with A[*kpoint]==k. If cosetrep==NULL then c itself is used in 
+   place of its cosetrep-image. The boolean array covered is workspace,
+   with room for k+1 entries. */
+{
+int j,point,part;
+for(j=1;j<=k;j++)
+   covered[j]=false;
+covered[A[newpoint]]=true;
+if(A[newpoint]==k)
+   *kpoint=newpoint;
+for(j=1;j<=k-1;j++)
    {
-   A[r]=i;
-   tp=TransversalProperty(n,k,cosetreps,adj,comb,A,Rnew,r);
-   if(!tp)
-      {
-      free(covered);
-      free(Rnew);
+   point=(cosetrep==NULL) ? c[j] : cosetrep[c[j]];
+   part=A[point];
+   if(covered[part])
+      /* part is covered twice */
       return false;
-      }
-   A[r]=k;
+   covered[part]=true;
+   if(part==k)
+      *kpoint=point;
    }
-free(covered);
-free(Rnew);
 return true;
 }
 
-int main(int argc, char *argv[])
-{  
-int n,k,i;
-bool result;
-intlist adj; /* the adjacency of vertex 1 in orbgraph (the graph encoding
-                the G-orbit on k-sets currently under consideration),
-                where G is a transitive permutation group */
-intlist *cosetreps; /* representatives for the right cosets in G of the
-                       stabilizer in G of 1 */ 
-intlist *comb; /* list of integer lists (in lex-order) of the 
-                  (k-1)-subsets of {1,...n}, indexed from 1 */
-intlist shortrep; 
-intlist A; /* an integer list representing a partition of {1,...,n}:
-              A[i]==j means that i is in the the j-th part  */
-bool *R; /* a boolean list representing a subset of {1,...,n}, so
-            for i=1,...,n, R[i]==true means that i is in the subset 
-            and R[i]==false means that i is not in the subset */
-scanf("%d %d",&n,&k);
-if((k<2) || (k>n))
+static inline bool IsTransversalBits(int k,intlist A,int newpoint,intlist c,
+                                     intlist cosetrep,int *kpoint)
+/* does the same as IsTransversal, for k<32, with the parts covered 
+   kept as the bits of a word */
+{
+int j,point,part;
+unsigned int covered,bit;
+covered=1u<<A[newpoint];
+if(A[newpoint]==k)
+   *kpoint=newpoint;
+for(j=1;j<=k-1;j++)
    {
-   fprintf(stderr,"\nbad input: must have 2<=k<=n\n");
-   exit(EXIT_FAILURE);
+   point=(cosetrep==NULL) ? c[j] : cosetrep[c[j]];
+   part=A[point];
+   bit=1u<<part;
+   if(covered&bit)
+      /* part is covered twice */
+      return false;
+   covered|=bit;
+   if(part==k)
+      *kpoint=point;
    }
-/* read in cosetreps */
-if((cosetreps=(intlist *)malloc(((unsigned)(n+1))*sizeof(intlist)))==NULL)
+return true;
+}
+
+static inline bool IsDone(orbitdata *od,int newpoint,int i,intlist cosetrep,
+                          int kpoint)
+/* Let K be the i-th k-subset in orb containing newpoint (in the 
+   order for ExtendR below), and let kpoint be in K. Returns true iff 
+   the search for the shortrep in the G-orbit of K minus kpoint has 
+   been completed. It is required that od->adjshortrep is not NULL. */
+{
+int p,row,k;
+intlist c;
+k=od->k;
+row=od->adjfirst[newpoint]+i;
+p=0;
+if(kpoint!=newpoint)
    {
-   fprintf(stderr,"\nmaking cosetreps error: malloc failed\n"); 
-   exit(EXIT_FAILURE);
+   /* find the position p of kpoint in the image of K for the orbit rep */
+   c=TableRow(od->adjcomb,k-1,row);
+   for(p=1;cosetrep[c[p]]!=kpoint;p++)
+      ;
    }
-for(i=1;i<=n;i++)
-   cosetreps[i]=IntListRead();
-adj=IntListRead();
-comb=Combinations(n,k-1); 
-A=IntList(n);
-if((R=(bool *)malloc(((unsigned)(n+1))*sizeof(bool)))==NULL)
+return atomic_load_explicit(
+          &od->done[TableRow(od->adjshortrep,k,row)[p+1]],
+          memory_order_relaxed);
+}
+
+/* The statistics of a search are counted by TransversalProperty and 
+   ExtendR in a searchstats (see the option -v). The depth of a call of 
+   TransversalProperty is Acount-(k-1), the number of points put in 
+   the first k-1 parts after those of the shortrep. */
+
+typedef struct
    {
-   fprintf(stderr,"\nmaking R error: malloc failed\n"); 
-   exit(EXIT_FAILURE);
+   unsigned long long nodes; /* the number of calls of TransversalProperty 
+                                (or of the tasks expanded by the threaded
+                                search) */
+   int maxdepth; /* the greatest depth of these calls */
+   unsigned long long adjscanned; /* the number of k-subsets looked at by 
+                                     ExtendR */
+   unsigned long long hits; /* the number of these which are transversals */
+   unsigned long long cutoffs; /* the number of returns by ExtendR on 
+                                  (Acount+*Rnewcount)*k>(k-1)*n */
+   unsigned long long doneprunes; /* the number of returns by ExtendR on 
+                                     meeting a completed shortrep */
+   unsigned long long symprunes; /* the number of returns by 
+                                    SymmetryPrune (option -y) */
+   } searchstats;
+
+void SearchStatsAdd(searchstats *sum,const searchstats *s)
+/* adds the statistics s to sum */
+{
+sum->nodes+=s->nodes;
+if(s->maxdepth>sum->maxdepth)
+   sum->maxdepth=s->maxdepth;
+sum->adjscanned+=s->adjscanned;
+sum->hits+=s->hits;
+sum->cutoffs+=s->cutoffs;
+sum->doneprunes+=s->doneprunes;
+sum->symprunes+=s->symprunes;
+}
+
+/* When the table od->images has been made, ExtendR can test the 
+   k-subsets through newpoint 8 at a time, by TransversalMask8, which 
+   uses AVX2 gathers to look up the parts of their points. This kernel 
+   is used (for k<32) when the CPU supports AVX2, unless the option 
+   -e scalar is given (see ExtendRCount below), in which case the 
+   scalar test IsTransversal is used throughout, as a reference. The
+   kernel only finds which of the 8 k-subsets are transversals, and 
+   each of these is then handled by the scalar code, in the same 
+   order, so that the search is the same in either case. */
+
+bool vectorkernel; /* true if TransversalMask8 is to be used */
+
+#ifdef HAVE_AVX2_KERNEL
+__attribute__((target("avx2")))
+static unsigned int TransversalMask8(intlist A,int k,int newpart,
+                                     intlist rows)
+/* Let rows be TableRow(od->images,k-1,r) for some r. Returns the 
+   bitmask with the bit t (t=0,...,7) set iff the parts of the points 
+   of the (k-1)-subset in TableRow(od->images,k-1,r+t), together with
+   newpart, are all of {1,...,k}, where k<32. */
+{
+__m256i one,offset,mask,points,parts;
+int j;
+one=_mm256_set1_epi32(1);
+offset=_mm256_mullo_epi32(_mm256_setr_epi32(0,1,2,3,4,5,6,7),
+                          _mm256_set1_epi32(k));
+mask=_mm256_set1_epi32((int)(1u<<(newpart-1)));
+for(j=1;j<=k-1;j++)
+   {
+   points=_mm256_i32gather_epi32(rows,
+                  _mm256_add_epi32(offset,_mm256_set1_epi32(j)),4);
+   parts=_mm256_i32gather_epi32(A,points,4);
+   mask=_mm256_or_si256(mask,
+                  _mm256_sllv_epi32(one,_mm256_sub_epi32(parts,one)));
    }
-result=true;  /* initially */
-while(Length(shortrep=IntListRead())!=0)
+/* the parts are distinct iff all the k bits of the mask are set */
+return (unsigned int)_mm256_movemask_ps(_mm256_castsi256_ps(
+          _mm256_cmpeq_epi32(mask,_mm256_set1_epi32((int)((1u<<k)-1u)))));
+}
+#endif
+
+/* ExtendR (below) has a version for each k in 2,...,MAX_FIXED_K, 
+   made by EXTENDR_FIXED_K from ExtendRFor with k a constant, so that 
+   the compiler can unroll the loops over the points of the k-subsets,
+   and a generic version for the other values of k, and it calls the 
+   one for od->k. For k<32, the parts covered by a k-subset are kept as 
+   the bits of a word (in a register) by IsTransversalBits. */
+
+#if defined(__GNUC__)
+#define ALWAYS_INLINE __attribute__((always_inline))
+#else
+#define ALWAYS_INLINE
+#endif
+
+static inline ALWAYS_INLINE bool ExtendRFor(orbitdata *od,intlist A,
+                                            int Acount,bitset Rnew,
+                                            int *Rnewcount,bool *covered,
+                                            int newpoint,searchstats *stats,
+                                            int k)
+/* does ExtendR, where k==od->k */
+{
+bool injective;
+int n,i,kpoint;
+intlist cosetrep;
+intlist c;
+#ifdef HAVE_AVX2_KERNEL
+unsigned int blockhits,rest;
+int blockfirst,blocklast;
+blockhits=0;
+blockfirst=0;
+blocklast=0; /* the k-subsets blockfirst,...,blocklast through newpoint 
+                have been tested by TransversalMask8, with the 
+                transversals given by blockhits */
+#endif
+kpoint=0; /* set by the transversal test before it is used */
+n=od->n;
+cosetrep=TableRow(od->cosetreps,n,newpoint); /* an element of G (in image
+                                                form) mapping 
+                                                od->orbitrep[newpoint] 
+                                                to newpoint */
+for(i=1;i<=od->numadjof[newpoint];i++)
    {
-   for(i=1;i<=n;i++)
+#ifdef HAVE_AVX2_KERNEL
+   if(vectorkernel && od->images!=NULL)
+      {
+      if(i>blocklast && i+7<=od->numadjof[newpoint])
+         {
+         blockfirst=i;
+         blocklast=i+7;
+         blockhits=TransversalMask8(A,k,A[newpoint],
+                      TableRow(od->images,k-1,od->imagefirst[newpoint]+i));
+         }
+      if(i<=blocklast)
+         {
+         /* skip to the next transversal in the block, if any */
+         rest=blockhits>>(i-blockfirst);
+         if(rest==0)
+            {
+            i=blocklast;
+            continue;
+            }
+         i+=TrailingZeros(rest);
+         }
+      }
+#endif
+   if(od->images!=NULL)
+      {
+      c=TableRow(od->images,k-1,od->imagefirst[newpoint]+i);
+      injective=(k<32) ? IsTransversalBits(k,A,newpoint,c,NULL,&kpoint)
+                       : IsTransversal(k,A,newpoint,c,NULL,covered,&kpoint);
+      }
+   else
+      {
+      c=TableRow(od->adjcomb,k-1,od->adjfirst[newpoint]+i);
+      injective=(k<32) 
+                ? IsTransversalBits(k,A,newpoint,c,cosetrep,&kpoint)
+                : IsTransversal(k,A,newpoint,c,cosetrep,covered,&kpoint);
+      }
+   if(injective)
+      {
+      stats->hits++;
+      /* is kpoint in the set represented by Rnew? */
+      if(!IsBitsetMember(Rnew,kpoint))
+         {
+         AddBitsetMember(Rnew,kpoint);
+         (*Rnewcount)++;
+         if((Acount+*Rnewcount)*k>(k-1)*n)
+            {
+            stats->adjscanned+=i;
+            stats->cutoffs++;
+            return true;
+            }
+         }
+      if(od->adjshortrep!=NULL 
+         && atomic_load_explicit(&od->numdone,memory_order_relaxed)>0
+         && IsDone(od,newpoint,i,cosetrep,kpoint))
+         {
+         stats->adjscanned+=i;
+         stats->doneprunes++;
+         return true;
+         }
+      }
+   }
+stats->adjscanned+=od->numadjof[newpoint];
+return false;
+}
+
+#define MAX_FIXED_K 8
+
+#define EXTENDR_FIXED_K(K) \
+static bool ExtendR##K(orbitdata *od,intlist A,int Acount,bitset Rnew, \
+                       int *Rnewcount,bool *covered,int newpoint, \
+                       searchstats *stats) \
+{ \
+return ExtendRFor(od,A,Acount,Rnew,Rnewcount,covered,newpoint,stats,K); \
+}
+
+EXTENDR_FIXED_K(2)
+EXTENDR_FIXED_K(3)
+EXTENDR_FIXED_K(4)
+EXTENDR_FIXED_K(5)
+EXTENDR_FIXED_K(6)
+EXTENDR_FIXED_K(7)
+EXTENDR_FIXED_K(8)
+
+bool ExtendR(orbitdata *od,intlist A,int Acount,bitset Rnew,int *Rnewcount,
+             bool *covered,int newpoint,searchstats *stats)
+/* Let od,A and newpoint be as for TransversalProperty
+   below, let Acount be the number of i in {1,...,n} with A[i]<k,
+   and let the bitset Rnew represent a subset of P[k] of size *Rnewcount.
+
+   This function adds to the subset represented by Rnew the point in P[k]
+   of each k-subset K in orb containing newpoint such that K is a 
+   transversal of P, updating *Rnewcount accordingly. The boolean array 
+   covered is workspace, and must have room for k+1 entries.
+
+   The function returns true as soon as (Acount+*Rnewcount)*k>(k-1)*n, 
+   or (if od->adjshortrep is not NULL) as soon as such a K is found with 
+   K minus its point in P[k] in the G-orbit of a shortrep whose search 
+   has been completed, in which case no counterexample can exist, 
+   and returns false otherwise. The work done is counted in *stats. */
+{
+switch(od->k)
+   {
+   case 2:
+      return ExtendR2(od,A,Acount,Rnew,Rnewcount,covered,newpoint,stats);
+   case 3:
+      return ExtendR3(od,A,Acount,Rnew,Rnewcount,covered,newpoint,stats);
+   case 4:
+      return ExtendR4(od,A,Acount,Rnew,Rnewcount,covered,newpoint,stats);
+   case 5:
+      return ExtendR5(od,A,Acount,Rnew,Rnewcount,covered,newpoint,stats);
+   case 6:
+      return ExtendR6(od,A,Acount,Rnew,Rnewcount,covered,newpoint,stats);
+   case 7:
+      return ExtendR7(od,A,Acount,Rnew,Rnewcount,covered,newpoint,stats);
+   case 8:
+      return ExtendR8(od,A,Acount,Rnew,Rnewcount,covered,newpoint,stats);
+   default:
+      return ExtendRFor(od,A,Acount,Rnew,Rnewcount,covered,newpoint,stats,
+                        od->k);
+   }
+}
+
+/* The search branches on a point r of the set represented by Rnew 
+   (whose part in a counterexample must be one of the first k-1), 
+   trying each of these parts for r in turn. The point r is chosen 
+   according to branchstrategy (the option -b), as:
+     BRANCH_FIRST: the least point (the default),
+     BRANCH_LAST: the greatest point,
+     BRANCH_COVER: a point s lying in the most k-subsets K in orb such 
+                   that the points of K other than s are in distinct 
+                   parts (so that putting s in the one part of 
+                   P[1],...,P[k-1] missed by such a K makes K a 
+                   transversal, with the aim of making R grow quickly),
+                   or the least such point if there are several (this 
+                   costs a scan of the k-subsets through each point 
+                   in R at each call),
+   and the parts are tried in the order given by partstrategy (the 
+   option -o), as:
+     PARTS_UP: P[1],...,P[k-1] (the default),
+     PARTS_DOWN: P[k-1],...,P[1],
+     PARTS_SMALL: in increasing order of size (and in increasing 
+                  order when of the same size),
+     PARTS_LARGE: in decreasing order of size (and in increasing 
+                  order when of the same size).
+   The counts of nodes (-v) can be used to compare these strategies. */
+
+#define BRANCH_FIRST 0
+#define BRANCH_LAST 1
+#define BRANCH_COVER 2
+
+#define PARTS_UP 0
+#define PARTS_DOWN 1
+#define PARTS_SMALL 2
+#define PARTS_LARGE 3
+
+int branchstrategy=BRANCH_FIRST;
+int partstrategy=PARTS_UP;
+
+int CoverScore(orbitdata *od,intlist A,int s,bool *covered)
+/* returns the number of the k-subsets K in orb containing s such 
+   that the points of K other than s are in distinct parts; covered 
+   is workspace (with room for k+1 entries) */
+{
+int n,k,i,j,point,score;
+intlist cosetrep,c;
+n=od->n;
+k=od->k;
+cosetrep=TableRow(od->cosetreps,n,s);
+score=0;
+for(i=1;i<=od->numadjof[s];i++)
+   {
+   if(od->images!=NULL)
+      c=TableRow(od->images,k-1,od->imagefirst[s]+i);
+   else
+      c=TableRow(od->adjcomb,k-1,od->adjfirst[s]+i);
+   for(j=1;j<=k;j++)
+      covered[j]=false;
+   for(j=1;j<=k-1;j++)
+      {
+      point=(od->images!=NULL) ? c[j] : cosetrep[c[j]];
+      if(covered[A[point]])
+         break;
+      covered[A[point]]=true;
+      }
+   if(j==k)
+      score++;
+   }
+return score;
+}
+
+int BranchPoint(orbitdata *od,intlist A,bitset Rnew,int nwords,
+                bool *covered)
+/* returns the point r in the nonempty set represented by Rnew on which 
+   to branch, as determined by branchstrategy; covered is workspace 
+   (with room for k+1 entries) */
+{
+int i,s,score,best,r;
+bitword w;
+if(branchstrategy==BRANCH_LAST)
+   return BitsetLast(Rnew,nwords);
+if(branchstrategy==BRANCH_COVER)
+   {
+   r=0;
+   best=-1;
+   for(i=0;i<nwords;i++)
+      for(w=Rnew[i];w!=0;w&=w-1)
+         {
+         s=i*WORDBITS+TrailingZeros(w);
+         score=CoverScore(od,A,s,covered);
+         if(score>best)
+            {
+            best=score;
+            r=s;
+            }
+         }
+   return r;
+   }
+return BitsetFirst(Rnew,nwords);
+}
+
+void PartSizes(int n,int k,intlist A,intlist partsize)
+/* sets partsize[i] to be the size of P[i], for i=1,...,k */
+{
+int i;
+for(i=1;i<=k;i++)
+   partsize[i]=0;
+for(i=1;i<=n;i++)
+   partsize[A[i]]++;
+}
+
+void PartOrder(int k,intlist partsize,int *order)
+/* sets order[1],...,order[k-1] to be the parts 1,...,k-1 in the order 
+   in which they are to be tried, as determined by partstrategy, 
+   where partsize[i] is the size of P[i] */
+{
+int i,j,x;
+for(j=1;j<=k-1;j++)
+   order[j]=(partstrategy==PARTS_DOWN) ? k-j : j;
+if(partstrategy==PARTS_SMALL || partstrategy==PARTS_LARGE)
+   /* insertion sort (which is stable) by size */
+   for(j=2;j<=k-1;j++)
+      {
+      x=order[j];
+      for(i=j;i>1 && (partstrategy==PARTS_SMALL 
+                      ? partsize[order[i-1]]>partsize[x]
+                      : partsize[order[i-1]]<partsize[x]);i--)
+         order[i]=order[i-1];
+      order[i]=x;
+      }
+}
+
+/* A checkpoint of a sequential search records the index of the 
+   shortrep whose search tree is being searched, and the path from 
+   the root of that tree to the current call of TransversalProperty, 
+   given by the point r and the position j (in the order in which the 
+   parts are tried) of the part chosen for it at each call on this path 
+   (which is kept in the workspace, see below). Since all the choices 
+   before these (the parts in the positions less than j for each r) 
+   have been searched completely, the search can then be resumed by going 
+   back down this path, and carrying on from there. For this, the 
+   search must be deterministic, which it is for a sequential search 
+   given the same input.
+
+   A checkpoint file consists of the CHECKPOINT_INFO numbers n, k, 
+   numadj, numshortreps, branchstrategy, partstrategy and the total 
+   number of the elements of G for SymmetryPrune (0 without -y) for the 
+   job (as a check that the input and the strategies are the same), then 
+   the index (from 0) of the shortrep, the number of pairs on the path, 
+   and the pairs r j (from the root down). */
+
+#define DEFAULT_CHECKPOINT_SECONDS 600
+
+#define CHECKPOINT_INFO 7
+
+#define CHECKPOINT_CALLS 16384 /* the number of calls of 
+                                  TransversalProperty between looks at 
+                                  the time, for checkpoints and progress 
+                                  reports (a power of 2) */
+
+volatile sig_atomic_t checkpointsignal; /* set by CheckpointSignal */
+
+void CheckpointSignal(int sig)
+{
+checkpointsignal=sig;
+}
+
+typedef struct
+   {
+   const char *filename; /* the checkpoint file */
+   double seconds; /* the time between checkpoints */
+   time_t last; /* the time of the last checkpoint (or of the start) */
+   int info[CHECKPOINT_INFO]; /* n, k, numadj, numshortreps, 
+                                branchstrategy, partstrategy and the 
+                                number of elements for SymmetryPrune,
+                                for the job */
+   int shortrep; /* the index (from 0) of the shortrep at which the 
+                    search is resumed */
+   int resumedepth; /* if not 0, then the calls at depths 1,...,resumedepth
+                       on the path are being resumed */
+   } checkpoint;
+
+/* The working storage for a search by TransversalProperty is allocated 
+   once, before the search starts, so that the search itself does no
+   memory allocation. Since |P[1]|+...+|P[k-1]| increases by 1 at each 
+   (nested) call, and is at most ((k-1)*n)/k at each call, the storage 
+   for the bitset Rnew and the frame of a call is indexed by 
+   Acount=|P[1]|+...+|P[k-1]|. The calls are not made by recursion 
+   in C, but by TransversalProperty itself, with their frames on this
+   explicit stack, so that the depth of the search is not limited by 
+   the size of the (thread's) C stack. */
+
+typedef struct
+   {
+   int newpoint; /* the argument newpoint of the call */
+   int r; /* the point r on which the call branches, or 0 if none */
+   int Rcount; /* the size of Rnew (without r) */
+   int j; /* the position (in the order in which the parts are tried) 
+             of the part for r of the current nested call */
+   } searchframe;
+
+typedef struct
+   {
+   int n,k;
+   int maxAcount; /* ((k-1)*n)/k */
+   int nwords; /* BitsetWords(n) */
+   bitword *Rstack; /* Rstack+Acount*nwords is the storage for the bitset 
+                       Rnew of a call of TransversalProperty with this 
+                       Acount */
+   bool *covered; /* workspace for ExtendR */
+   int rootAcount; /* the Acount at the root of the current search tree 
+                      (in a threaded search, of the shortrep of the 
+                      current task) */
+   intlist pathr,pathpart; /* the call at depth d on the path from that 
+                              root to the current call (the call with 
+                              Acount==rootAcount+d-1) has chosen the part 
+                              in the position pathpart[d] (in the order
+                              in which the parts are tried) for the 
+                              point pathr[d] */
+   int taskdepth; /* in a threaded search, the depth on that path of the 
+                     call at the root of the current task (0 otherwise) */
+   intlist partsize; /* partsize[i] is the size of P[i] at the current
+                        call, for i=1,...,k */
+   int *orderstack; /* orderstack+Acount*k holds (from position 1) the 
+                       order in which the parts are tried at a call 
+                       with this Acount */
+   searchframe *frames; /* frames[Acount] is the frame of the call with 
+                           this Acount */
+   int shortrep,numshortreps; /* the current search is in the tree of the 
+                                 shortrep with this index (from 1), of 
+                                 numshortreps */
+   int task,ntasks; /* in a threaded search, the current search is for 
+                       the task with this index (from 1), of ntasks */
+   searchstats stats;
+   checkpoint *cp; /* the checkpoint for the search, or NULL if none */
+   int kcapacity; /* the number of k-subsets for which there is room in 
+                     kmask, ksum and kdead (see ExtendRCount below) */
+   bitword *kmask;
+   int *ksum,*kdead;
+   int *kupdated; /* kupdated[Acount] is the number of k-subsets updated by
+                     ExtendRCount at the call with this Acount */
+   } workspace;
+
+workspace *NewWorkspace(int n,int k)
+/* returns a new workspace for searches on {1,...,n} with given k */
+{
+workspace *ws;
+if((ws=(workspace *)malloc(sizeof(workspace)))==NULL)
+   {
+   fprintf(stderr,"\nNewWorkspace error: malloc failed\n"); 
+   exit(EXIT_FAILURE);
+   }
+ws->n=n;
+ws->k=k;
+ws->maxAcount=((k-1)*n)/k;
+ws->nwords=BitsetWords(n);
+if((ws->Rstack=(bitword *)malloc(((size_t)(ws->maxAcount+1))*
+                                 ((size_t)ws->nwords)*sizeof(bitword)))==NULL)
+   {
+   fprintf(stderr,"\nNewWorkspace error: malloc failed\n"); 
+   exit(EXIT_FAILURE);
+   }
+if((ws->covered=(bool *)malloc(((unsigned)(k+1))*sizeof(bool)))==NULL)
+   {
+   fprintf(stderr,"\nNewWorkspace error: malloc failed\n"); 
+   exit(EXIT_FAILURE);
+   }
+ws->pathr=IntList(ws->maxAcount);
+ws->pathpart=IntList(ws->maxAcount);
+ws->partsize=IntList(k);
+if((ws->orderstack=(int *)malloc(((size_t)(ws->maxAcount+1))*
+                                 ((size_t)k)*sizeof(int)))==NULL)
+   {
+   fprintf(stderr,"\nNewWorkspace error: malloc failed\n"); 
+   exit(EXIT_FAILURE);
+   }
+if((ws->frames=(searchframe *)malloc(((size_t)(ws->maxAcount+1))*
+                                    sizeof(searchframe)))==NULL)
+   {
+   fprintf(stderr,"\nNewWorkspace error: malloc failed\n"); 
+   exit(EXIT_FAILURE);
+   }
+ws->rootAcount=0;
+ws->taskdepth=0;
+ws->shortrep=0;
+ws->numshortreps=0;
+ws->task=0;
+ws->ntasks=0;
+memset(&ws->stats,0,sizeof(searchstats));
+ws->cp=NULL;
+ws->kcapacity=0;
+ws->kmask=NULL;
+ws->ksum=NULL;
+ws->kdead=NULL;
+if((ws->kupdated=(int *)malloc(((size_t)(ws->maxAcount+1))*sizeof(int)))
+   ==NULL)
+   {
+   fprintf(stderr,"\nNewWorkspace error: malloc failed\n"); 
+   exit(EXIT_FAILURE);
+   }
+return ws;
+}
+
+void FreeWorkspace(workspace *ws)
+{
+free(ws->kupdated);
+free(ws->kdead);
+free(ws->ksum);
+free(ws->kmask);
+free(ws->frames);
+free(ws->orderstack);
+free(ws->partsize);
+free(ws->pathpart);
+free(ws->pathr);
+free(ws->covered);
+free(ws->Rstack);
+free(ws);
+}
+
+checkpoint *NewCheckpoint(const char *filename,double seconds,orbitdata *od,
+                          int numshortreps,workspace *ws)
+/* returns a new checkpoint for the search for the job given by od and 
+   numshortreps, which is set up to resume the search from the state
+   saved in the checkpoint file filename, if this exists (with the 
+   path then put in ws) */
+{
+checkpoint *cp;
+FILE *f;
+int i,d,x;
+if((cp=(checkpoint *)malloc(sizeof(checkpoint)))==NULL)
+   {
+   fprintf(stderr,"\nNewCheckpoint error: malloc failed\n"); 
+   exit(EXIT_FAILURE);
+   }
+cp->filename=filename;
+cp->seconds=seconds;
+cp->last=time(NULL);
+cp->info[0]=od->n;
+cp->info[1]=od->k;
+cp->info[2]=od->numadj;
+cp->info[3]=numshortreps;
+cp->info[4]=branchstrategy;
+cp->info[5]=partstrategy;
+cp->info[6]=0;
+if(od->sym!=NULL)
+   for(i=1;i<=numshortreps;i++)
+      cp->info[6]+=od->numsym[i];
+cp->shortrep=0;
+cp->resumedepth=0;
+if((f=fopen(filename,"r"))==NULL)
+   return cp; /* a new search */
+for(i=0;i<CHECKPOINT_INFO;i++)
+   if(fscanf(f,"%d",&x)!=1 || x!=cp->info[i])
+      {
+      fprintf(stderr,
+         "\nNewCheckpoint error: %s is not a checkpoint for this input\n",
+              filename);
+      exit(EXIT_FAILURE);
+      }
+if(fscanf(f,"%d%d",&cp->shortrep,&cp->resumedepth)!=2 
+   || cp->shortrep<0 || cp->shortrep>=numshortreps 
+   || cp->resumedepth<0 || cp->resumedepth>ws->maxAcount)
+   {
+   fprintf(stderr,"\nNewCheckpoint error: bad checkpoint file %s\n",
+           filename);
+   exit(EXIT_FAILURE);
+   }
+for(d=1;d<=cp->resumedepth;d++)
+   if(fscanf(f,"%d%d",&ws->pathr[d],&ws->pathpart[d])!=2 
+      || ws->pathr[d]<1 || ws->pathr[d]>od->n 
+      || ws->pathpart[d]<1 || ws->pathpart[d]>od->k-1)
+      {
+      fprintf(stderr,"\nNewCheckpoint error: bad checkpoint file %s\n",
+              filename);
+      exit(EXIT_FAILURE);
+      }
+fclose(f);
+return cp;
+}
+
+void CheckpointWrite(workspace *ws,int Acount)
+/* saves the state of the search at a call of TransversalProperty with 
+   the given Acount (which has not yet chosen a point r) in the 
+   checkpoint file of ws->cp, by writing a new file and renaming it, 
+   so that the checkpoint file is always complete */
+{
+FILE *f;
+char *tmpname;
+int i,d,depth;
+size_t len;
+checkpoint *cp;
+cp=ws->cp;
+depth=Acount-ws->rootAcount;
+if(depth<cp->resumedepth)
+   /* still going back down the path, which is kept in full */
+   depth=cp->resumedepth;
+len=strlen(cp->filename)+5;
+if((tmpname=(char *)malloc(len))==NULL)
+   {
+   fprintf(stderr,"\nCheckpointWrite error: malloc failed\n"); 
+   exit(EXIT_FAILURE);
+   }
+snprintf(tmpname,len,"%s.tmp",cp->filename);
+if((f=fopen(tmpname,"w"))==NULL)
+   {
+   /* carry on with the search, which is worth more than the checkpoint */
+   fprintf(stderr,"\nCheckpointWrite warning: cannot write %s\n",tmpname);
+   free(tmpname);
+   return;
+   }
+for(i=0;i<CHECKPOINT_INFO;i++)
+   fprintf(f,"%d ",cp->info[i]);
+fprintf(f,"\n%d %d\n",ws->shortrep-1,depth);
+for(d=1;d<=depth;d++)
+   fprintf(f,"%d %d\n",ws->pathr[d],ws->pathpart[d]);
+if(fclose(f)!=0 || rename(tmpname,cp->filename)!=0)
+   fprintf(stderr,"\nCheckpointWrite warning: cannot write %s\n",
+           cp->filename);
+free(tmpname);
+}
+
+/* With the option -p seconds, a progress report is written to the 
+   standard error every progressseconds seconds, by whichever thread
+   first finds that the time for this has come. */
+
+double progressseconds; /* 0 if there are no progress reports */
+time_t progresslast; /* the time of the last report (or of the start) */
+pthread_mutex_t progressmutex=PTHREAD_MUTEX_INITIALIZER;
+
+void ProgressWrite(workspace *ws,int Acount)
+/* writes a progress report for the search using ws, at a call
+   of TransversalProperty with the given Acount, including an estimate 
+   of the proportion of the current search tree (or task) done, which 
+   takes each of the k-1 parts at each call on the path to be equally 
+   costly */
+{
+int d;
+double weight,done;
+weight=1.0;
+done=0.0;
+for(d=ws->taskdepth+1;d<=Acount-ws->rootAcount;d++)
+   {
+   weight/=ws->k-1;
+   done+=(ws->pathpart[d]-1)*weight;
+   }
+fprintf(stderr,"tpexternal: shortrep %d of %d",ws->shortrep,
+        ws->numshortreps);
+if(ws->ntasks>0)
+   fprintf(stderr,", task %d of %d",ws->task,ws->ntasks);
+fprintf(stderr,", about %.1f%% done, depth %d, %llu calls, "
+        "max depth %d, %llu adj scanned, %llu hits, %llu cutoffs, "
+        "%llu done prunes, %llu symmetry prunes\n",100.0*done,
+        Acount-(ws->k-1),ws->stats.nodes,ws->stats.maxdepth,
+        ws->stats.adjscanned,ws->stats.hits,ws->stats.cutoffs,
+        ws->stats.doneprunes,ws->stats.symprunes);
+}
+
+void SearchClock(workspace *ws,int Acount)
+/* called by TransversalProperty (at a call with the given Acount) every
+   CHECKPOINT_CALLS calls and on a checkpoint signal, to make the 
+   checkpoints and progress reports which are due */
+{
+time_t now;
+now=time(NULL);
+if(ws->cp!=NULL 
+   && (checkpointsignal || difftime(now,ws->cp->last)>=ws->cp->seconds))
+   {
+   CheckpointWrite(ws,Acount);
+   ws->cp->last=now;
+   if(checkpointsignal)
+      {
+      fprintf(stderr,"\nsearch checkpointed in %s on signal %d\n",
+              ws->cp->filename,(int)checkpointsignal);
+      exit(EXIT_FAILURE);
+      }
+   }
+if(progressseconds>0)
+   {
+   pthread_mutex_lock(&progressmutex);
+   if(difftime(now,progresslast)>=progressseconds)
+      {
+      ProgressWrite(ws,Acount);
+      progresslast=now;
+      }
+   pthread_mutex_unlock(&progressmutex);
+   }
+}
+
+/* With the option -e count (when od->kset is not NULL), ExtendR is
+   replaced by ExtendRCount, which keeps, for each k-subset K in orb, 
+   the parts P[j] (j<k) of the points of K in P[1],...,P[k-1], as the 
+   bitword kmask[K] in the workspace (with the bit j-1 set for P[j]),
+   and the sum ksum[K] of these points. Then K is a transversal of P
+   if and only if kmask[K] has all its k-1 bits set (for then K has 
+   k-1 points in distinct parts P[1],...,P[k-1], and its other point, 
+   ksetsum[K]-ksum[K], in P[k]), so the test for K costs O(1) rather 
+   than O(k) lookups. When two points of K are found to be in the same 
+   part P[j] (j<k), K cannot become a transversal in the subtree of the 
+   call, and kdead[K] is set to the Acount of the call (or to -1 at the 
+   root), after which K is left alone until this is undone. The updates 
+   for newpoint made by a call are undone (by CountsUndo) when it 
+   returns true. As the k-subsets through newpoint are taken in the 
+   same order as by ExtendR, the search is the same for both engines. */
+
+#define ENGINE_SCAN 0
+#define ENGINE_COUNT 1
+#define ENGINE_SCALAR 2 /* ENGINE_SCAN without TransversalMask8 */
+
+int engine=ENGINE_SCAN;
+
+void CountsAlloc(workspace *ws,int numksets)
+/* makes room in ws for the counts for numksets k-subsets */
+{
+if(numksets<=ws->kcapacity)
+   return;
+free(ws->kmask);
+free(ws->ksum);
+free(ws->kdead);
+if((ws->kmask=(bitword *)malloc(((size_t)(numksets+1))*sizeof(bitword)))
+      ==NULL
+   || (ws->ksum=(int *)malloc(((size_t)(numksets+1))*sizeof(int)))==NULL
+   || (ws->kdead=(int *)malloc(((size_t)(numksets+1))*sizeof(int)))==NULL)
+   {
+   fprintf(stderr,"\nCountsAlloc error: malloc failed\n"); 
+   exit(EXIT_FAILURE);
+   }
+ws->kcapacity=numksets;
+}
+
+static inline bool CountsAdd(workspace *ws,int K,bitword bit,int point,
+                             int dead,bitword full)
+/* adds point (in the part given by bit) to the counts for the K-th 
+   k-subset, and returns true iff K has then become a transversal */
+{
+if(ws->kdead[K]!=0)
+   return false;
+if(ws->kmask[K]&bit)
+   {
+   ws->kdead[K]=dead;
+   return false;
+   }
+ws->kmask[K]|=bit;
+ws->ksum[K]+=point;
+return ws->kmask[K]==full;
+}
+
+void CountsInit(orbitdata *od,intlist A,int newpoint,workspace *ws)
+/* sets up the counts in ws for the partition represented by A, but 
+   with newpoint taken to be in P[k], at the root of a search */
+{
+int n,k,i,j,K;
+bitword full;
+n=od->n;
+k=od->k;
+full=(((bitword)1)<<(k-2)<<1)-1;
+CountsAlloc(ws,od->numksets);
+for(K=1;K<=od->numksets;K++)
+   {
+   ws->kmask[K]=0;
+   ws->ksum[K]=0;
+   ws->kdead[K]=0;
+   }
+for(i=1;i<=n;i++)
+   if(A[i]<k && i!=newpoint)
+      for(j=1;j<=od->numadjof[i];j++)
+         CountsAdd(ws,od->kset[od->imagefirst[i]+j],((bitword)1)<<(A[i]-1),
+                   i,-1,full);
+}
+
+bool ExtendRCount(orbitdata *od,intlist A,int Acount,bitset Rnew,
+                  int *Rnewcount,int newpoint,workspace *ws)
+/* does the same as ExtendR (with the work counted in ws->stats), using
+   and updating the counts in ws (for the partition with newpoint 
+   in P[k]) for newpoint */
+{
+int n,k,i,K,kpoint;
+bitword bit,full;
+int *kset;
+intlist cosetrep;
+n=od->n;
+k=od->k;
+full=(((bitword)1)<<(k-2)<<1)-1;
+bit=((bitword)1)<<(A[newpoint]-1);
+kset=od->kset+od->imagefirst[newpoint];
+cosetrep=TableRow(od->cosetreps,n,newpoint);
+for(i=1;i<=od->numadjof[newpoint];i++)
+   {
+   K=kset[i];
+   if(CountsAdd(ws,K,bit,newpoint,Acount,full))
+      {
+      ws->stats.hits++;
+      kpoint=od->ksetsum[K]-ws->ksum[K];
+      if(!IsBitsetMember(Rnew,kpoint))
+         {
+         AddBitsetMember(Rnew,kpoint);
+         (*Rnewcount)++;
+         if((Acount+*Rnewcount)*k>(k-1)*n)
+            {
+            ws->kupdated[Acount]=i;
+            ws->stats.adjscanned+=i;
+            ws->stats.cutoffs++;
+            return true;
+            }
+         }
+      if(od->adjshortrep!=NULL 
+         && atomic_load_explicit(&od->numdone,memory_order_relaxed)>0
+         && IsDone(od,newpoint,i,cosetrep,kpoint))
+         {
+         ws->kupdated[Acount]=i;
+         ws->stats.adjscanned+=i;
+         ws->stats.doneprunes++;
+         return true;
+         }
+      }
+   }
+ws->kupdated[Acount]=od->numadjof[newpoint];
+ws->stats.adjscanned+=od->numadjof[newpoint];
+return false;
+}
+
+void CountsUndo(orbitdata *od,intlist A,int Acount,int newpoint,
+                workspace *ws)
+/* undoes the updates of the counts in ws made by ExtendRCount at the 
+   call with the given Acount (and A and newpoint) */
+{
+int i,K;
+bitword bit;
+int *kset;
+bit=((bitword)1)<<(A[newpoint]-1);
+kset=od->kset+od->imagefirst[newpoint];
+for(i=1;i<=ws->kupdated[Acount];i++)
+   {
+   K=kset[i];
+   if(ws->kdead[K]==Acount)
+      ws->kdead[K]=0;
+   else if(ws->kdead[K]==0)
+      {
+      ws->kmask[K]&=~bit;
+      ws->ksum[K]-=newpoint;
+      }
+   }
+}
+
+/* Each return of true by a call of TransversalProperty (below) means 
+   that there is no counterexample Q with Q[i] containing P[i] for 
+   i=1,...,k-1, where P is the partition at that call. Now let H be 
+   the subgroup of G fixing each point of the shortrep at the root 
+   of the search tree. Since H preserves orb and the part of each point 
+   of the shortrep, if Q is a counterexample, then so is its image Q^h 
+   (with Q^h[i] the image of Q[i]) for each h in H. So a call can be 
+   cut short (returning true) if g(P'[i]) is contained in P[i] for
+   i=1,...,k-1, for some g in H and some partition P' at the root of 
+   a subtree which has already been searched, since then any 
+   counterexample Q at the call would give the counterexample Q^(g^-1) 
+   in that subtree. 
+
+   With the option -y, this is tested by SymmetryPrune for the elements 
+   g of H given in the input, and for the subtrees of the (earlier) 
+   siblings of the calls on the path from the root of the search. 
+   For the call at depth d on this path, which puts the point r into 
+   the part P[i], these are the partitions with r put into the parts 
+   P[i'] tried before P[i]. As the points put into P[1],...,P[k-1] on 
+   the path are just those of the shortrep (fixed by g) and the points 
+   r of its calls, it suffices to run through these points r, until 
+   g(r) is found not to be in the same part as r. In a threaded search,
+   the path runs from the root of the search tree of the shortrep, 
+   through the calls made when the tasks are expanded (see 
+   ThreadedTransversalProperty below), to the current call. */
+
+bool SymmetryPrune(orbitdata *od,intlist A,int Acount,workspace *ws)
+/* Returns true if the call of TransversalProperty (below) for A and 
+   Acount can be cut short for one of the elements of G in 
+   od->sym[ws->shortrep], as described above, and false otherwise. */
+{
+int n,k,i,d,r,part,j;
+int *order;
+intlist g;
+n=od->n;
+k=od->k;
+for(i=1;i<=od->numsym[ws->shortrep];i++)
+   {
+   g=TableRow(od->sym[ws->shortrep],n,i);
+   for(d=1;d<=Acount-ws->rootAcount;d++)
+      {
+      r=ws->pathr[d];
+      part=A[g[r]];
+      if(part==A[r])
+         continue;
+      if(part<k)
+         {
+         /* is part tried before A[r] by the call at depth d? */
+         order=ws->orderstack+((size_t)(ws->rootAcount+d-1))*((size_t)k);
+         for(j=1;j<ws->pathpart[d];j++)
+            if(order[j]==part)
+               return true;
+         }
+      break;
+      }
+   }
+return false;
+}
+
+bool TransversalProperty(orbitdata *od,intlist A,int Acount,bitset R,
+                         int Rcount,int newpoint,workspace *ws,
+                         atomic_bool *stop)
+/* Let od represent a G-orbit orb of k-subsets of {1,...,n}, 
+   where G is a group on {1,...,n} and k>1. Thus, the 
+   (k-1)-subsets extending i (in {1,...,n}) to a k-subset in the 
+   represented G-orbit are the images of those in od->adjcomb 
+   for the orbit rep od->orbitrep[i] under the i-th coset rep in 
+   od->cosetreps.
+
+   Let A represent an ordered k-partition [P[1],...,P[k]]
+   of {1,...,n}, where A is an integer list of length n,
+   such that A[i]==j means that i is in the j-th part P[j] of P.
+
+   Let the bitset R represent a subset S of {1,...,n}, of size Rcount.
+   It is required that A[s]==k for all s in S (i.e. R represents 
+   a subset contained in P[k]).
+
+   Let newpoint be an element of {1,...,n} such that A[newpoint] < k
+   (i.e newpoint is in one of P[1],...,P[k-1]), and let Acount be
+   |P[1]|+...+|P[k-1]| (i.e. the number of i with A[i]<k).
+
+   Furthermore, suppose that Acount<=((k-1)*n)/k, and 
+   for every k-subset K in orb not containing newpoint,
+   if the intersection of K with each of P[1],...,P[k-1]
+   has size 1, then the remaining point of K is in the subset S
+   represented by R.
+   
+   Then this boolean function returns true if for every k-partition Q of
+   {1,...,n} satisfying:
+     - Q[i] contains P[i] for i=1,...,k-1,
+     - no element of S (represented by R) is in Q[k],
+     - |Q[k]| >= n/k,
+   there is a k-set in orb forming a transversal of Q.
+ 
+   Otherwise, this function returns false. 
+
+   The search is abandoned as soon as *stop is found to be true
+   (this is set by another thread which has found a counterexample),
+   in which case the value returned is true, and is meaningless. 
+
+   The storage used by the search is taken from the workspace ws 
+   (made by NewWorkspace(n,k)), and the bitset R must not be stored in 
+   ws->Rstack at the position for Acount or greater. The sizes of the
+   parts of P must be in ws->partsize. The path to the call, from the 
+   call with Acount==ws->rootAcount, is kept in ws, and the work done 
+   is counted in ws->stats. If ws->cp is not NULL, then 
+   the search is checkpointed in ws->cp (see checkpoint above). If 
+   od->sym is not NULL, then the search is pruned by SymmetryPrune. 
+   If od->kset is not NULL, then the counts in ws must be those for
+   A with newpoint in P[k] (see ExtendRCount above), and these are 
+   restored when the call returns true. The nested calls of the 
+   search are made by this function itself, with their frames in ws 
+   (see workspace above), rather than by recursion. */
+{
+bool entering,cut;
+bitset Rnew;
+int k,rootAcount,Rnewcount,i,r,first,depth;
+int *order;
+checkpoint *cp;
+searchframe *f;
+k=od->k;
+rootAcount=Acount;
+entering=true;
+for(;;)
+   {
+   if(entering)
+      {
+      /* enter the call with Acount, newpoint and R (of size Rcount) */
+      if(atomic_load_explicit(stop,memory_order_relaxed))
+         return true;
+      ws->stats.nodes++;
+      if(Acount-(k-1)>ws->stats.maxdepth)
+         ws->stats.maxdepth=Acount-(k-1);
+      if((ws->stats.nodes&(CHECKPOINT_CALLS-1))==0 || checkpointsignal)
+         SearchClock(ws,Acount);
+      f=&ws->frames[Acount];
+      f->newpoint=newpoint;
+      f->r=0; /* until a point r is chosen (if the call does not return 
+                 true at once) */
+      if(od->sym!=NULL && SymmetryPrune(od,A,Acount,ws))
+         ws->stats.symprunes++;
+      else
+         {
+         Rnew=ws->Rstack+((size_t)Acount)*((size_t)ws->nwords);
+         memcpy(Rnew,R,((size_t)ws->nwords)*sizeof(bitword));
+         Rnewcount=Rcount;
+         if(od->kset!=NULL)
+            {
+            cut=ExtendRCount(od,A,Acount,Rnew,&Rnewcount,newpoint,ws);
+            if(cut)
+               CountsUndo(od,A,Acount,newpoint,ws);
+            }
+         else
+            cut=ExtendR(od,A,Acount,Rnew,&Rnewcount,ws->covered,newpoint,
+                        &ws->stats);
+         if(!cut)
+            {
+            if(Rnewcount==0)
+               return false; /* A represents a counterexample */
+            r=BranchPoint(od,A,Rnew,ws->nwords,ws->covered);
+            /* remove r from the set represented by Rnew */
+            RemoveBitsetMember(Rnew,r);
+            Rnewcount--;
+            order=ws->orderstack+((size_t)Acount)*((size_t)k);
+            PartOrder(k,ws->partsize,order);
+            first=1;
+            depth=Acount-ws->rootAcount+1; /* of the call on the path */
+            cp=ws->cp;
+            if(cp!=NULL && depth<=cp->resumedepth)
+               {
+               /* go back down the path of the checkpoint */
+               if(r!=ws->pathr[depth])
+                  {
+                  fprintf(stderr,"\nTransversalProperty error: checkpoint %s "
+                          "does not match the search\n",cp->filename);
+                  exit(EXIT_FAILURE);
+                  }
+               first=ws->pathpart[depth];
+               if(depth==cp->resumedepth)
+                  cp->resumedepth=0; /* the end of the path */
+               }
+            f->r=r;
+            f->Rcount=Rnewcount;
+            f->j=first-1;
+            }
+         }
+      }
+   else
+      {
+      /* back from the call for the part order[f->j] of r, which 
+         returned true */
+      f=&ws->frames[Acount];
+      i=ws->orderstack[((size_t)Acount)*((size_t)k)+f->j];
+      ws->partsize[i]--;
+      ws->partsize[k]++;
+      A[f->r]=k;
+      }
+   if(f->r!=0 && ++f->j<=k-1)
+      {
+      /* now try putting r in the next of the first k-1 parts of the 
+         ordered partition represented by A */
+      r=f->r;
+      i=ws->orderstack[((size_t)Acount)*((size_t)k)+f->j];
+      A[r]=i;
+      ws->partsize[i]++;
+      ws->partsize[k]--;
+      depth=Acount-ws->rootAcount+1;
+      ws->pathr[depth]=r;
+      ws->pathpart[depth]=f->j;
+      R=ws->Rstack+((size_t)Acount)*((size_t)ws->nwords);
+      Rcount=f->Rcount;
+      newpoint=r;
+      Acount++;
+      entering=true;
+      continue;
+      }
+   /* the call returns true */
+   if(f->r!=0 && od->kset!=NULL)
+      CountsUndo(od,A,Acount,f->newpoint,ws);
+   if(Acount==rootAcount)
+      return true;
+   Acount--;
+   entering=false;
+   }
+}
+
+/* For the threaded search, the search trees for the shortreps are 
+   first expanded (breadth-first) near their roots, until there are 
+   at least TASKS_PER_THREAD*nthreads independent subtrees (tasks), 
+   or no more subtrees to expand. The worker threads then take tasks 
+   from the resulting pool one at a time, until the pool is exhausted 
+   or some worker finds a counterexample. */
+
+#define TASKS_PER_THREAD 16
+
+typedef struct
+   {
+   intlist A; /* the partition at the root of the subtree */
+   int Acount;
+   bitset R;
+   int Rcount;
+   int newpoint; 
+   int shortrep; /* the index (from 1) of the shortrep at the root 
+                    of the search tree containing the subtree */
+   intlist pathr,pathpart; /* the path from the root of that search tree 
+                              to the root of the subtree, as for the 
+                              workspace (of length the depth of the root
+                              of the subtree in the tree) */
+   int *orders; /* orders+(d-1)*k holds (from position 1) the order in 
+                   which the parts are tried at the call at depth d on 
+                   that path */
+   } task; /* the arguments for a call of TransversalProperty */
+
+typedef struct
+   {
+   orbitdata *od;
+   task *tasks;
+   int ntasks;
+   atomic_int *pending; /* pending[s] is the number of the tasks in the 
+                           search tree of the s-th shortrep which are 
+                           not yet finished */
+   atomic_int next; /* the index of the next task to be taken */
+   atomic_bool stop; /* set to true when a counterexample is found */
+   intlist counterexample; /* set to the counterexample found first */
+   pthread_mutex_t statsmutex; /* for stats and shortrepnodes */
+   searchstats stats; /* the statistics of the tasks finished so far */
+   unsigned long long *shortrepnodes; /* shortrepnodes[s] is the number 
+                                         of nodes counted in stats for 
+                                         the tree of the s-th shortrep */
+   } taskpool;
+
+void AddTask(taskpool *pool,int *capacity,intlist A,int Acount,bitset R,
+             int Rcount,int newpoint,int shortrep,int parent,int j,
+             intlist order)
+/* adds a new task for (copies of) A and R, and Acount, Rcount, 
+   newpoint and shortrep, to the end of pool. If parent is -1, then the 
+   task is at the root of the search tree of the shortrep, and otherwise 
+   it is a child of the task pool->tasks[parent], with the point newpoint 
+   put into the part in the position j of the order in which the parts 
+   are tried, given by the integer list order (of length k-1) */
+{
+int i,n,k,depth;
+task *t,*p;
+n=pool->od->n;
+k=pool->od->k;
+if(pool->ntasks==*capacity)
+   {
+   *capacity=2*(*capacity)+16;
+   if((pool->tasks=(task *)realloc(pool->tasks,
+                     ((unsigned)(*capacity))*sizeof(task)))==NULL)
+      {
+      fprintf(stderr,"\nAddTask error: realloc failed\n"); 
+      exit(EXIT_FAILURE);
+      }
+   }
+t=&pool->tasks[pool->ntasks++];
+t->A=IntList(n);
+t->R=Bitset(n);
+for(i=1;i<=n;i++)
+   t->A[i]=A[i];
+memcpy(t->R,R,((size_t)BitsetWords(n))*sizeof(bitword));
+t->Acount=Acount;
+t->Rcount=Rcount;
+t->newpoint=newpoint;
+t->shortrep=shortrep;
+p=(parent<0)?NULL:&pool->tasks[parent];
+depth=(p==NULL)?0:Length(p->pathr)+1;
+t->pathr=IntList(depth);
+t->pathpart=IntList(depth);
+if((t->orders=(int *)malloc((((size_t)depth)*((size_t)k)+1)*sizeof(int)))
+   ==NULL)
+   {
+   fprintf(stderr,"\nAddTask error: malloc failed\n"); 
+   exit(EXIT_FAILURE);
+   }
+if(p!=NULL)
+   {
+   for(i=1;i<depth;i++)
+      {
+      t->pathr[i]=p->pathr[i];
+      t->pathpart[i]=p->pathpart[i];
+      }
+   memcpy(t->orders,p->orders,((size_t)(depth-1))*((size_t)k)*sizeof(int));
+   t->pathr[depth]=newpoint;
+   t->pathpart[depth]=j;
+   memcpy(t->orders+((size_t)(depth-1))*((size_t)k),order,
+          ((size_t)k)*sizeof(int));
+   }
+atomic_fetch_add(&pool->pending[shortrep],1);
+}
+
+void TaskFinished(taskpool *pool,task *t)
+/* records that the task t has been finished (without finding a 
+   counterexample), so that the search for its shortrep is completed 
+   once all its tasks are finished */
+{
+if(atomic_fetch_sub(&pool->pending[t->shortrep],1)==1)
+   {
+   atomic_store(&pool->od->done[t->shortrep],true);
+   atomic_fetch_add(&pool->od->numdone,1);
+   }
+}
+
+void *TaskWorker(void *arg)
+/* the function run by each worker thread */
+{
+taskpool *pool;
+task *t;
+workspace *ws;
+int i,k,d;
+pool=(taskpool *)arg;
+k=pool->od->k;
+ws=NewWorkspace(pool->od->n,pool->od->k);
+ws->ntasks=pool->ntasks;
+while(!atomic_load(&pool->stop) 
+      && (i=atomic_fetch_add(&pool->next,1))<pool->ntasks)
+   {
+   t=&pool->tasks[i];
+   ws->task=i+1;
+   ws->shortrep=t->shortrep;
+   /* continue the path of the search tree of the shortrep down to the 
+      root of the task, for SymmetryPrune */
+   ws->taskdepth=Length(t->pathr);
+   ws->rootAcount=t->Acount-ws->taskdepth;
+   for(d=1;d<=ws->taskdepth;d++)
+      {
+      ws->pathr[d]=t->pathr[d];
+      ws->pathpart[d]=t->pathpart[d];
+      }
+   memcpy(ws->orderstack+((size_t)ws->rootAcount)*((size_t)k),t->orders,
+          ((size_t)ws->taskdepth)*((size_t)k)*sizeof(int));
+   PartSizes(pool->od->n,pool->od->k,t->A,ws->partsize);
+   if(pool->od->kset!=NULL)
+      CountsInit(pool->od,t->A,t->newpoint,ws);
+   memset(&ws->stats,0,sizeof(searchstats));
+   if(!TransversalProperty(pool->od,t->A,t->Acount,t->R,t->Rcount,
+                           t->newpoint,ws,&pool->stop))
+      {
+      /* t->A has been left as a counterexample */
+      if(!atomic_exchange(&pool->stop,true))
+         memcpy(pool->counterexample,t->A,
+                ((size_t)(pool->od->n+1))*sizeof(int));
+      }
+   else
+      TaskFinished(pool,t);
+   pthread_mutex_lock(&pool->statsmutex);
+   SearchStatsAdd(&pool->stats,&ws->stats);
+   pool->shortrepnodes[t->shortrep]+=ws->stats.nodes;
+   pthread_mutex_unlock(&pool->statsmutex);
+   }
+FreeWorkspace(ws);
+return NULL;
+}
+
+bool ThreadedTransversalProperty(orbitdata *od,intlist *shortreps,
+                                 int numshortreps,int nthreads,
+                                 intlist counterexample,searchstats *stats,
+                                 unsigned long long *shortrepnodes)
+/* Returns true if TransversalProperty returns true for each of 
+   the given shortreps (shortreps[0],...,shortreps[numshortreps-1]), 
+   and false otherwise, using nthreads worker threads, in which case 
+   the integer list counterexample (of length n) is set to represent
+   a counterexample. The statistics of the search are put in *stats, 
+   and the number of nodes in the tree of the s-th shortrep in 
+   shortrepnodes[s] (for s=1,...,numshortreps). */
+{
+taskpool pool;
+pthread_t *threads;
+task *t;
+intlist A,partsize,order;
+bitset Rnew;
+bool *covered;
+bool result;
+int n,k,capacity,head,Rnewcount,i,j,r;
+n=od->n;
+k=od->k;
+partsize=IntList(k);
+order=IntList(k-1);
+pool.od=od;
+pool.tasks=NULL;
+pool.ntasks=0;
+atomic_init(&pool.next,0);
+atomic_init(&pool.stop,false);
+pthread_mutex_init(&pool.statsmutex,NULL);
+memset(&pool.stats,0,sizeof(searchstats));
+pool.shortrepnodes=shortrepnodes;
+pool.counterexample=counterexample;
+if((pool.pending=(atomic_int *)malloc(((size_t)(numshortreps+1))*
+                                      sizeof(atomic_int)))==NULL)
+   {
+   fprintf(stderr,"\nThreadedTransversalProperty error: malloc failed\n"); 
+   exit(EXIT_FAILURE);
+   }
+for(i=1;i<=numshortreps;i++)
+   {
+   atomic_init(&pool.pending[i],0);
+   shortrepnodes[i]=0;
+   }
+capacity=0;
+Rnew=Bitset(n); /* empty */
+if((covered=(bool *)malloc(((unsigned)(k+1))*sizeof(bool)))==NULL)
+   {
+   fprintf(stderr,"\nThreadedTransversalProperty error: malloc failed\n"); 
+   exit(EXIT_FAILURE);
+   }
+/* make the root tasks */
+A=IntList(n);
+for(i=0;i<numshortreps;i++)
+   {
+   for(j=1;j<=n;j++)
+      A[j]=k;
+   for(j=1;j<=Length(shortreps[i]);j++)
+      A[shortreps[i][j]]=j;
+   AddTask(&pool,&capacity,A,Length(shortreps[i]),Rnew,0,shortreps[i][1],
+           i+1,-1,0,NULL);
+   }
+free(A);
+/* expand the tasks tasks[head],...,tasks[ntasks-1] still in the pool,
+   breadth-first, in the same way as done by TransversalProperty */
+result=true; /* initially */
+head=0;
+while(head<pool.ntasks && pool.ntasks-head<TASKS_PER_THREAD*nthreads)
+   {
+   t=&pool.tasks[head++];
+   pool.stats.nodes++;
+   if(t->Acount-(k-1)>pool.stats.maxdepth)
+      pool.stats.maxdepth=t->Acount-(k-1);
+   shortrepnodes[t->shortrep]++;
+   memcpy(Rnew,t->R,((size_t)BitsetWords(n))*sizeof(bitword));
+   Rnewcount=t->Rcount;
+   if(ExtendR(od,t->A,t->Acount,Rnew,&Rnewcount,covered,t->newpoint,
+              &pool.stats))
+      {
+      TaskFinished(&pool,t);
+      continue;
+      }
+   if(Rnewcount==0)
+      {
+      /* t->A represents a counterexample */
+      memcpy(counterexample,t->A,((size_t)(n+1))*sizeof(int));
+      result=false;
+      break;
+      }
+   r=BranchPoint(od,t->A,Rnew,BitsetWords(n),covered);
+   RemoveBitsetMember(Rnew,r);
+   Rnewcount--;
+   PartSizes(n,k,t->A,partsize);
+   PartOrder(k,partsize,order);
+   for(j=1;j<=k-1;j++)
+      {
+      t->A[r]=order[j];
+      AddTask(&pool,&capacity,t->A,t->Acount+1,Rnew,Rnewcount,r,t->shortrep,
+              head-1,j,order);
+      t=&pool.tasks[head-1]; /* the pool may have been moved by realloc */
+      }
+   /* t is replaced by its children */
+   TaskFinished(&pool,t);
+   }
+if(result)
+   {
+   atomic_store(&pool.next,head);
+   if((threads=(pthread_t *)malloc(((unsigned)nthreads)*sizeof(pthread_t)))
+      ==NULL)
+      {
+      fprintf(stderr,"\nThreadedTransversalProperty error: malloc failed\n"); 
+      exit(EXIT_FAILURE);
+      }
+   for(i=0;i<nthreads;i++)
+      if(pthread_create(&threads[i],NULL,TaskWorker,&pool)!=0)
+         {
+         fprintf(stderr,
+            "\nThreadedTransversalProperty error: pthread_create failed\n"); 
+         exit(EXIT_FAILURE);
+         }
+   for(i=0;i<nthreads;i++)
+      pthread_join(threads[i],NULL);
+   free(threads);
+   result=!atomic_load(&pool.stop);
+   }
+for(i=0;i<pool.ntasks;i++)
+   {
+   free(pool.tasks[i].A);
+   free(pool.tasks[i].R);
+   free(pool.tasks[i].pathr);
+   free(pool.tasks[i].pathpart);
+   free(pool.tasks[i].orders);
+   }
+free(pool.tasks);
+free(pool.pending);
+free(covered);
+free(Rnew);
+free(order);
+free(partsize);
+pthread_mutex_destroy(&pool.statsmutex);
+*stats=pool.stats;
+return result;
+}
+
+bool SequentialTransversalProperty(orbitdata *od,intlist *shortreps,
+                                   int numshortreps,workspace *ws,
+                                   intlist counterexample,searchstats *stats,
+                                   unsigned long long *shortrepnodes)
+/* Returns true if TransversalProperty returns true for each of 
+   the given shortreps (shortreps[0],...,shortreps[numshortreps-1]), 
+   taken in order, and false otherwise. If ws->cp is not NULL, then 
+   the search starts from the shortrep (and the path) in ws->cp, the 
+   searches for the shortreps before it having been completed. 
+   The counterexample and the statistics are returned as for 
+   ThreadedTransversalProperty. */
+{
+int n,k,i,j,first;
+unsigned long long nodes;
+bool result;
+atomic_bool stop;
+intlist A; /* an integer list representing a partition of {1,...,n}:
+              A[i]==j means that i is in the the j-th part  */
+bitset R; /* the empty subset of {1,...,n} */
+n=od->n;
+k=od->k;
+A=IntList(n);
+R=Bitset(n);
+atomic_init(&stop,false); /* never set, as there is just one thread */
+result=true;  /* initially */
+memset(&ws->stats,0,sizeof(searchstats));
+ws->numshortreps=numshortreps;
+first=(ws->cp!=NULL) ? ws->cp->shortrep : 0;
+for(i=0;i<first;i++)
+   {
+   atomic_store(&od->done[i+1],true);
+   atomic_fetch_add(&od->numdone,1);
+   }
+for(i=1;i<=numshortreps;i++)
+   shortrepnodes[i]=0;
+for(i=first;i<numshortreps && result;i++)
+   {
+   ws->shortrep=i+1;
+   ws->rootAcount=Length(shortreps[i]);
+   nodes=ws->stats.nodes;
+   for(j=1;j<=n;j++)
+      A[j]=k;
+   for(j=1;j<=Length(shortreps[i]);j++)
+      A[shortreps[i][j]]=j;
+   PartSizes(n,k,A,ws->partsize);
+   if(od->kset!=NULL)
+      CountsInit(od,A,shortreps[i][1],ws);
+   result=TransversalProperty(od,A,Length(shortreps[i]),R,0,shortreps[i][1],
+                              ws,&stop);
+   shortrepnodes[i+1]=ws->stats.nodes-nodes;
+   if(result)
+      {
+      atomic_store(&od->done[i+1],true);
+      atomic_fetch_add(&od->numdone,1);
+      }
+   else
+      /* A has been left as a counterexample */
+      memcpy(counterexample,A,((size_t)(n+1))*sizeof(int));
+   }
+free(R);
+free(A);
+*stats=ws->stats;
+return result;
+}
+
+intlist *ShortrepsRead(int *numshortreps)
+/* Reads in the shortreps from the standard input (as integer lists, up 
+   to and including a list of length 0), and returns them as the array
+   shortreps[0],...,shortreps[*numshortreps-1] of integer lists. */
+{
+int capacity;
+intlist shortrep;
+intlist *shortreps;
+*numshortreps=0;
+capacity=16;
+if((shortreps=(intlist *)malloc(((unsigned)capacity)*sizeof(intlist)))
+   ==NULL)
+   {
+   fprintf(stderr,"\nShortrepsRead error: malloc failed\n"); 
+   exit(EXIT_FAILURE);
+   }
+while(Length(shortrep=IntListRead())!=0)
+   {
+   if(*numshortreps==capacity)
+      {
+      capacity*=2;
+      if((shortreps=(intlist *)realloc(shortreps,
+                        ((unsigned)capacity)*sizeof(intlist)))==NULL)
+         {
+         fprintf(stderr,"\nShortrepsRead error: realloc failed\n"); 
+         exit(EXIT_FAILURE);
+         }
+      }
+   shortreps[(*numshortreps)++]=shortrep;
+   }
+free(shortrep);
+return shortreps;
+}
+
+void SymmetriesRead(orbitdata *od,intlist *shortreps,int numshortreps)
+/* Reads in, for each of the shortreps (shortreps[0],...,
+   shortreps[numshortreps-1]), the elements of G fixing its points for 
+   SymmetryPrune (as integer lists of length n, up to and including a 
+   list of length 0), and puts these in od->sym and od->numsym. */
+{
+int n,s,capacity,length,i,j;
+intlist g;
+n=od->n;
+if((od->sym=(intlisttable *)malloc(((size_t)(numshortreps+1))*
+                                   sizeof(intlisttable)))==NULL
+   || (od->numsym=(int *)malloc(((size_t)(numshortreps+1))*sizeof(int)))
+      ==NULL)
+   {
+   fprintf(stderr,"\nSymmetriesRead error: malloc failed\n"); 
+   exit(EXIT_FAILURE);
+   }
+od->sym[0]=NULL;
+od->numsym[0]=0;
+for(s=1;s<=numshortreps;s++)
+   {
+   capacity=4;
+   od->sym[s]=IntListTable(capacity,n);
+   od->numsym[s]=0;
+   for(;;)
+      {
+      if(!ReadInt(&length) || (length!=0 && length!=n))
+         {
+         fprintf(stderr,"\nSymmetriesRead error: an element of G must be "
+                 "a list of length n\n"); 
+         exit(EXIT_FAILURE);
+         }
+      if(length==0)
+         break;
+      if(od->numsym[s]==capacity)
+         {
+         capacity*=2;
+         if((od->sym[s]=(intlisttable)realloc(od->sym[s],
+                           ((size_t)(capacity+1))*((size_t)(n+1))*
+                           sizeof(int)))==NULL)
+            {
+            fprintf(stderr,"\nSymmetriesRead error: realloc failed\n"); 
+            exit(EXIT_FAILURE);
+            }
+         }
+      g=TableRow(od->sym[s],n,++od->numsym[s]);
+      SetLength(g,n);
+      for(i=1;i<=n;i++)
+         if(!ReadInt(&g[i]) || g[i]<1 || g[i]>n)
+            {
+            fprintf(stderr,"\nSymmetriesRead error: bad point in an "
+                    "element of G\n"); 
+            exit(EXIT_FAILURE);
+            }
+      for(j=1;j<=Length(shortreps[s-1]);j++)
+         if(g[shortreps[s-1][j]]!=shortreps[s-1][j])
+            {
+            fprintf(stderr,"\nSymmetriesRead error: an element does not "
+                    "fix its shortrep\n"); 
+            exit(EXIT_FAILURE);
+            }
+      }
+   }
+}
+
+void FreeSymmetries(orbitdata *od,int numshortreps)
+{
+int s;
+if(od->sym==NULL)
+   return;
+for(s=1;s<=numshortreps;s++)
+   free(od->sym[s]);
+free(od->sym);
+free(od->numsym);
+od->sym=NULL;
+od->numsym=NULL;
+}
+
+/* In strong mode (option -S), the program includes a C version of my 
+   GAP function StrongTransversalProperty, which is applied for a given 
+   G-orbit orb of tuples [T,U], where T is a 2-subset and U is a 
+   (k-1)-subset of {1,...,n} disjoint from T, and a given sequence of 
+   shortreps. The orbit is given explicitly, by its tuples, which are 
+   indexed by point: as a transversal Union([T[1]],U) of the partition 
+   P at a node has just one point in each part of P, the node only 
+   needs to consider the tuples through the points of the smallest 
+   of the parts P[1],...,P[k-1]. */
+
+typedef struct
+   {
+   int n,k;
+   int numtuples; /* the number of tuples in orb */
+   intlisttable tuples; /* for i=1,...,numtuples, TableRow(tuples,k+1,i) 
+                           is the i-th tuple [T,U] in orb, given as the 
+                           list T[1],T[2],U[1],...,U[k-1] */
+   int *bypointstart;
+   int *bypoint; /* bypoint[bypointstart[x]],...,bypoint[bypointstart[x+1]-1]
+                    are the i such that x is in Union([T[1]],U) for the 
+                    i-th tuple [T,U] */
+   } strongorbitdata;
+
+void StrongOrbitIndex(strongorbitdata *sod)
+/* makes sod->bypointstart and sod->bypoint for sod->tuples */
+{
+int n,k,i,j,x;
+intlist tuple;
+int *next;
+n=sod->n;
+k=sod->k;
+if((sod->bypointstart=(int *)calloc((size_t)(n+2),sizeof(int)))==NULL
+   || (sod->bypoint=(int *)malloc((((size_t)sod->numtuples)*k+1)*sizeof(int)))
+      ==NULL
+   || (next=(int *)malloc(((size_t)(n+1))*sizeof(int)))==NULL)
+   {
+   fprintf(stderr,"\nStrongOrbitIndex error: malloc failed\n"); 
+   exit(EXIT_FAILURE);
+   }
+/* count the tuples through each point */
+for(i=1;i<=sod->numtuples;i++)
+   {
+   tuple=TableRow(sod->tuples,k+1,i);
+   sod->bypointstart[tuple[1]+1]++;
+   for(j=3;j<=k+1;j++)
+      sod->bypointstart[tuple[j]+1]++;
+   }
+for(x=1;x<=n;x++)
+   {
+   sod->bypointstart[x+1]+=sod->bypointstart[x];
+   next[x]=sod->bypointstart[x];
+   }
+for(i=1;i<=sod->numtuples;i++)
+   {
+   tuple=TableRow(sod->tuples,k+1,i);
+   sod->bypoint[next[tuple[1]]++]=i;
+   for(j=3;j<=k+1;j++)
+      sod->bypoint[next[tuple[j]]++]=i;
+   }
+free(next);
+}
+
+intlisttable TuplesRead(int n,int k,int *numtuples)
+/* Reads in the tuples of orb from the standard input (as integer lists 
+   of length k+1, up to and including a list of length 0), and returns 
+   them as a table, with *numtuples rows of length k+1. Returns NULL if 
+   the end of the input or a negative length is read in place of the 
+   first tuple. */
+{
+int capacity,length,i,x;
+intlisttable T;
+intlist tuple;
+*numtuples=0;
+if(!ReadInt(&length) || length<0)
+   return NULL;
+capacity=16;
+if((T=(intlisttable)malloc(((size_t)(capacity+1))*((size_t)(k+2))*
+                           sizeof(int)))==NULL)
+   {
+   fprintf(stderr,"\nTuplesRead error: malloc failed\n"); 
+   exit(EXIT_FAILURE);
+   }
+while(length!=0)
+   {
+   if(length!=k+1)
+      {
+      fprintf(stderr,"\nTuplesRead error: a tuple must have length k+1\n"); 
+      exit(EXIT_FAILURE);
+      }
+   if(*numtuples==capacity)
+      {
+      capacity*=2;
+      if((T=(intlisttable)realloc(T,((size_t)(capacity+1))*((size_t)(k+2))*
+                                  sizeof(int)))==NULL)
+         {
+         fprintf(stderr,"\nTuplesRead error: realloc failed\n"); 
+         exit(EXIT_FAILURE);
+         }
+      }
+   tuple=TableRow(T,k+1,++(*numtuples));
+   SetLength(tuple,k+1);
+   for(i=1;i<=k+1;i++)
+      {
+      if(!ReadInt(&x) || x<1 || x>n)
+         {
+         fprintf(stderr,"\nTuplesRead error: bad point in a tuple\n"); 
+         exit(EXIT_FAILURE);
+         }
+      tuple[i]=x;
+      }
+   if(tuple[1]==tuple[2])
+      {
+      fprintf(stderr,"\nTuplesRead error: T must be a 2-subset\n"); 
+      exit(EXIT_FAILURE);
+      }
+   if(!ReadInt(&length))
+      {
+      fprintf(stderr,"\nTuplesRead error: unexpected end of input\n"); 
+      exit(EXIT_FAILURE);
+      }
+   }
+return T;
+}
+
+/* A node of the strong search builds the sets R and S from scratch, 
+   and only needs them until it has chosen the point or the pair 
+   to branch on, so they are kept in a single strongworkspace shared
+   by all the nodes. Membership of R, of S, and of the matching used 
+   for the independent set bound, is recorded by stamping with the 
+   generation number of the set concerned, so that these sets never 
+   need to be cleared. */
+
+typedef struct
+   {
+   int n,k;
+   unsigned int gen; /* the current generation number */
+   unsigned int *Rstamp; /* r is in R iff Rstamp[r]==gen */
+   unsigned int *Sstamp; /* the pair {a,b} (a<b) is in S iff 
+                            Sstamp[(a-1)*n+b-1]==gen */
+   unsigned int *matchstamp; /* for the bound, point x is in a pair of 
+                                the matching iff matchstamp[x]==gen */
+   int *S; /* S[2*i],S[2*i+1] (a<b) is the i-th pair in S (0-based) */
+   int Scount; /* the number of pairs in S */
+   bool *covered; /* covered[j] is true iff a point in part j has 
+                     been seen */
+   int *partsize; /* partsize[j] is the size of part j of P */
+   } strongworkspace;
+
+strongworkspace *NewStrongWorkspace(int n,int k,int numtuples)
+/* returns a new strongworkspace for orbits of at most numtuples 
+   tuples on {1,...,n}, with given k */
+{
+strongworkspace *sws;
+if((sws=(strongworkspace *)malloc(sizeof(strongworkspace)))==NULL
+   || (sws->Rstamp=(unsigned int *)calloc((size_t)(n+1),
+                                          sizeof(unsigned int)))==NULL
+   || (sws->Sstamp=(unsigned int *)calloc(((size_t)n)*((size_t)n),
+                                          sizeof(unsigned int)))==NULL
+   || (sws->matchstamp=(unsigned int *)calloc((size_t)(n+1),
+                                              sizeof(unsigned int)))==NULL
+   || (sws->S=(int *)malloc(2*((size_t)numtuples+1)*sizeof(int)))==NULL
+   || (sws->covered=(bool *)malloc(((unsigned)(k+1))*sizeof(bool)))==NULL
+   || (sws->partsize=(int *)malloc(((unsigned)(k+1))*sizeof(int)))==NULL)
+   {
+   fprintf(stderr,"\nNewStrongWorkspace error: malloc failed\n"); 
+   exit(EXIT_FAILURE);
+   }
+sws->n=n;
+sws->k=k;
+sws->gen=0;
+sws->Scount=0;
+return sws;
+}
+
+void FreeStrongWorkspace(strongworkspace *sws)
+{
+free(sws->partsize);
+free(sws->covered);
+free(sws->S);
+free(sws->matchstamp);
+free(sws->Sstamp);
+free(sws->Rstamp);
+free(sws);
+}
+
+static inline unsigned int NextGeneration(strongworkspace *sws)
+/* returns a new generation number, clearing the stamps if the 
+   generation numbers have wrapped around */
+{
+int n;
+n=sws->n;
+if(++sws->gen==0)
+   {
+   memset(sws->Rstamp,0,((size_t)(n+1))*sizeof(unsigned int));
+   memset(sws->Sstamp,0,((size_t)n)*((size_t)n)*sizeof(unsigned int));
+   memset(sws->matchstamp,0,((size_t)(n+1))*sizeof(unsigned int));
+   sws->gen=1;
+   }
+return sws->gen;
+}
+
+bool StrongTransversalProperty(strongorbitdata *sod,intlist A,int Acount,
+                               strongworkspace *sws)
+/* Let sod represent the G-orbit orb of tuples [T,U], where T is a 
+   2-subset and U is a (k-1)-subset of {1,...,n} disjoint from T, 
+   with 2<=k<=n-1.
+
+   Let A represent an ordered k-partition P=[P[1],...,P[k]] of 
+   {1,...,n}, where A is an integer list of length n, such that 
+   A[i]==j means that i is in the j-th part P[j] of P, and let 
+   Acount be |P[1]|+...+|P[k-1]|, where Acount<=((k-1)*n)/k.
+
+   Then this boolean function returns true if for every k-partition Q 
+   of {1,...,n} satisfying:
+     - Q[i] contains P[i] for i=1,...,k-1,
+     - |Q[k]| >= n/k,
+   there is an element g in G such that:
+     - T[1]^g and T[2]^g are in the same part of Q,
+     - Union([T[1]],U)^g is a transversal of Q.
+
+   Otherwise, this function returns false. */
+{
+int n,k,i,j,a,b,kpoint,Rcount,Rmax,Scount,matchcount,s[2],x,t,part;
+unsigned int gen,*Rstamp,*Sstamp,*matchstamp;
+int *S,*partsize;
+bool *covered;
+intlist tuple;
+long long bound;
+n=sws->n;
+k=sws->k;
+bound=((long long)(k-1))*n;
+gen=NextGeneration(sws);
+Rstamp=sws->Rstamp;
+Sstamp=sws->Sstamp;
+S=sws->S;
+covered=sws->covered;
+Rcount=0; /* R is maintained as a subset of {1,...,n}, such that no 
+             element of R can be in the k-th part of a counterexample */
+Rmax=0; /* the largest element of R (if any) */
+Scount=0; /* S is maintained as a set of 2-subsets of {1,...,n}, 
+             such that, if {a,b} is in S, then either a or b (or both)
+             cannot be in the k-th part of a counterexample */
+/* find the smallest part P[part] with part<k */
+partsize=sws->partsize;
+for(j=1;j<=k;j++)
+   partsize[j]=0;
+for(x=1;x<=n;x++)
+   partsize[A[x]]++;
+part=1;
+for(j=2;j<k;j++)
+   if(partsize[j]<partsize[part])
+      part=j;
+for(x=1;x<=n;x++)
+   {
+   if(A[x]!=part)
+      continue;
+   for(t=sod->bypointstart[x];t<sod->bypointstart[x+1];t++)
+      {
+      /* loop invariant: 
+           - R is a subset of P[k],
+           - S is a set of 2-subsets of P[k], such that
+             every element of S is disjoint from R. */
+      tuple=TableRow(sod->tuples,k+1,sod->bypoint[t]);
+      a=tuple[1];
+      b=tuple[2];
+      if(A[a]!=A[b])
+         continue;
+      /* determine whether K=Union(U,[a]) is a transversal of P, and
+         if so, find the point kpoint of K in P[k] */
+      for(j=1;j<=k;j++)
+         covered[j]=false;
+      covered[A[a]]=true;
+      kpoint=(A[a]==k ? a : 0);
+      for(j=3;j<=k+1;j++)
+         {
+         if(covered[A[tuple[j]]])
+            break;
+         covered[A[tuple[j]]]=true;
+         if(A[tuple[j]]==k)
+            kpoint=tuple[j];
+         }
+      if(j<=k+1)
+         continue; 
+      if(kpoint==a)
+         {
+         /* either a or b (or both) cannot be in the k-th part 
+            of a counterexample */
+         if(a>b)
+            {
+            a=b;
+            b=kpoint;
+            }
+         if(Sstamp[(size_t)(a-1)*n+b-1]!=gen && Rstamp[a]!=gen 
+            && Rstamp[b]!=gen)
+            {
+            Sstamp[(size_t)(a-1)*n+b-1]=gen;
+            S[2*Scount]=a;
+            S[2*Scount+1]=b;
+            Scount++;
+            if((Acount+Rcount+1)*(long long)k>bound)
+               /* no counterexample exists */
+               return true;
+            }
+         }
+      else if(Rstamp[kpoint]!=gen)
+         {
+         /* kpoint cannot be in the k-th part of a counterexample */
+         Rstamp[kpoint]=gen;
+         Rcount++;
+         if(kpoint>Rmax)
+            Rmax=kpoint;
+         if((Acount+Rcount)*(long long)k>bound)
+            return true;
+         /* remove the pairs containing kpoint from S */
+         for(j=0;j<Scount;j++)
+            if(S[2*j]==kpoint || S[2*j+1]==kpoint)
+               {
+               Sstamp[(size_t)(S[2*j]-1)*n+S[2*j+1]-1]=0;
+               Scount--;
+               S[2*j]=S[2*Scount];
+               S[2*j+1]=S[2*Scount+1];
+               j--;
+               }
+         if(Scount>0 && (Acount+Rcount+1)*(long long)k>bound)
+            return true;
+         }
+      }
+   }
+if(Rcount==0 && Scount==0)
+   /* A represents a counterexample */
+   return false;
+if(Scount>1 && (Acount+Rcount+Scount)*(long long)k>bound)
+   {
+   /* The pairs in a matching (a set of pairwise disjoint pairs) in S 
+      need distinct points outside the k-th part of a counterexample. 
+      We use a greedily made matching. */
+   matchstamp=sws->matchstamp;
+   matchcount=0;
+   for(j=0;j<Scount;j++)
+      if(matchstamp[S[2*j]]!=gen && matchstamp[S[2*j+1]]!=gen)
+         {
+         matchstamp[S[2*j]]=gen;
+         matchstamp[S[2*j+1]]=gen;
+         matchcount++;
+         }
+   if((Acount+Rcount+matchcount)*(long long)k>bound)
+      /* There are not enough elements left from {1,...,n} to form the 
+         k-th part of a counterexample. */
+      return true;
+   }
+if(Rcount>0)
+   {
+   /* branch on the largest element of R */
+   s[0]=Rmax;
+   s[1]=0;
+   }
+else
+   {
+   /* R is empty and S is non-empty: branch on the (lexicographically)
+      last pair in S */
+   s[0]=S[0];
+   s[1]=S[1];
+   for(j=1;j<Scount;j++)
+      if(S[2*j]>s[0] || (S[2*j]==s[0] && S[2*j+1]>s[1]))
+         {
+         s[0]=S[2*j];
+         s[1]=S[2*j+1];
+         }
+   }
+/* R and S (in sws) are not used after this point, so that the 
+   recursive calls below can reuse the workspace */
+for(j=0;j<2 && s[j]!=0;j++)
+   {
+   for(i=1;i<=k-1;i++)
+      {
+      /* try to build a counterexample with s[j] in the i-th part */
+      A[s[j]]=i;
+      if(!StrongTransversalProperty(sod,A,Acount+1,sws))
+         return false;
+      A[s[j]]=k;
+      }
+   }
+return true;
+}
+
+bool SequentialStrongTransversalProperty(strongorbitdata *sod,
+                                         intlist *shortreps,
+                                         int numshortreps,
+                                         strongworkspace *sws)
+/* Returns true if StrongTransversalProperty returns true for each of 
+   the given shortreps (shortreps[0],...,shortreps[numshortreps-1]), 
+   taken in order, and false otherwise. */
+{
+int n,k,i,j;
+bool result;
+intlist A;
+n=sod->n;
+k=sod->k;
+A=IntList(n);
+result=true;  /* initially */
+for(i=0;i<numshortreps && result;i++)
+   {
+   for(j=1;j<=n;j++)
+      A[j]=k;
+   for(j=1;j<=Length(shortreps[i]);j++)
+      A[shortreps[i][j]]=j;
+   result=StrongTransversalProperty(sod,A,Length(shortreps[i]),sws);
+   }
+free(A);
+return result;
+}
+
+double Seconds()
+/* returns the time in seconds (from some fixed time) */
+{
+struct timespec ts;
+clock_gettime(CLOCK_MONOTONIC,&ts);
+return ts.tv_sec+1e-9*ts.tv_nsec;
+}
+
+void SearchStatsWrite(const searchstats *stats,double seconds,
+                      const unsigned long long *shortrepnodes,
+                      int numshortreps)
+/* writes the statistics of a search to the standard output, as a GAP 
+   record on one line (see the option -v) */
+{
+int i;
+struct rusage ru;
+if(getrusage(RUSAGE_SELF,&ru)!=0)
+   ru.ru_maxrss=0;
+printf("rec(nodes:=%llu,maxdepth:=%d,adjscanned:=%llu,hits:=%llu,"
+       "cutoffs:=%llu,doneprunes:=%llu,symprunes:=%llu,seconds:=%.3f,"
+       "maxrsskb:=%ld,shortrepnodes:=[",stats->nodes,stats->maxdepth,
+       stats->adjscanned,stats->hits,stats->cutoffs,stats->doneprunes,
+       stats->symprunes,seconds,(long)ru.ru_maxrss);
+for(i=1;i<=numshortreps;i++)
+   printf(i<numshortreps ? "%llu," : "%llu",shortrepnodes[i]);
+printf("])\n");
+}
+
+/* With the option -G file, the group data (the coset reps and the orbit 
+   reps) read from the input are also written to the given group cache 
+   file, and with the option -g file, they are instead taken from that 
+   file (made by an earlier run with -G), which is mapped read-only into 
+   memory, so that they are not read in again, and the runs for the 
+   same group on a machine share one copy of them. With either option, 
+   n and k in the input are followed by the generators of G (in image 
+   form, as integer lists of length n, up to and including a list of 
+   length 0), which are kept in the file, and with -g these must be 
+   the same as those in the file, and the input then has no coset reps 
+   or orbit reps. 
+
+   A group cache file consists of the integers GROUPCACHE_MAGIC, n, 
+   intransitive (1 for the option -i, 0 otherwise) and the number of 
+   generators, then the generators (each as an integer list of length n,
+   with its length first), then the table cosetreps (with its unused 
+   row 0 as zeros), and then the list orbitrep, all as in memory (so
+   the file is for the machine on which it is made). */
+
+#define GROUPCACHE_MAGIC 0x31475054
+
+intlisttable GeneratorsRead(int n,int *numgens)
+/* Reads in the generators of G for a group cache file from the standard 
+   input (as integer lists of length n, up to and including a list of
+   length 0), and returns them as a table, with *numgens rows. */
+{
+int capacity,length,i;
+intlisttable gens;
+intlist g;
+*numgens=0;
+capacity=4;
+gens=IntListTable(capacity,n);
+for(;;)
+   {
+   if(!ReadInt(&length) || (length!=0 && length!=n))
+      {
+      fprintf(stderr,"\nGeneratorsRead error: a generator must be a list "
+              "of length n\n"); 
+      exit(EXIT_FAILURE);
+      }
+   if(length==0)
+      break;
+   if(*numgens==capacity)
+      {
+      capacity*=2;
+      if((gens=(intlisttable)realloc(gens,((size_t)(capacity+1))*
+                                     ((size_t)(n+1))*sizeof(int)))==NULL)
+         {
+         fprintf(stderr,"\nGeneratorsRead error: realloc failed\n"); 
+         exit(EXIT_FAILURE);
+         }
+      }
+   g=TableRow(gens,n,++(*numgens));
+   SetLength(g,n);
+   for(i=1;i<=n;i++)
+      if(!ReadInt(&g[i]) || g[i]<1 || g[i]>n)
+         {
+         fprintf(stderr,"\nGeneratorsRead error: bad point in a "
+                 "generator\n"); 
+         exit(EXIT_FAILURE);
+         }
+   }
+return gens;
+}
+
+void GroupCacheWrite(const char *filename,orbitdata *od,bool intransitive,
+                     intlisttable gens,int numgens)
+/* writes the group cache file filename for od->cosetreps, od->orbitrep 
+   and the given generators, by writing a new file and renaming it, 
+   so that the file is always complete (a failure here only gives a 
+   warning, as the run itself can go on) */
+{
+FILE *f;
+char *tmpname;
+size_t len;
+int n,header[4];
+bool ok;
+n=od->n;
+len=strlen(filename)+32;
+if((tmpname=(char *)malloc(len))==NULL)
+   {
+   fprintf(stderr,"\nGroupCacheWrite error: malloc failed\n"); 
+   exit(EXIT_FAILURE);
+   }
+snprintf(tmpname,len,"%s.%ld.tmp",filename,(long)getpid());
+if((f=fopen(tmpname,"wb"))==NULL)
+   {
+   fprintf(stderr,"\nGroupCacheWrite warning: cannot write %s\n",tmpname);
+   free(tmpname);
+   return;
+   }
+header[0]=GROUPCACHE_MAGIC;
+header[1]=n;
+header[2]=intransitive;
+header[3]=numgens;
+memset(od->cosetreps,0,((size_t)(n+1))*sizeof(int)); /* row 0 */
+ok=fwrite(header,sizeof(int),4,f)==4
+   && fwrite(TableRow(gens,n,1),sizeof(int),((size_t)numgens)*(n+1),f)
+      ==((size_t)numgens)*(n+1)
+   && fwrite(od->cosetreps,sizeof(int),((size_t)(n+1))*(n+1),f)
+      ==((size_t)(n+1))*(n+1)
+   && fwrite(od->orbitrep,sizeof(int),(size_t)(n+1),f)==(size_t)(n+1);
+if(fclose(f)!=0 || !ok || rename(tmpname,filename)!=0)
+   {
+   fprintf(stderr,"\nGroupCacheWrite warning: cannot write %s\n",filename);
+   remove(tmpname);
+   }
+free(tmpname);
+}
+
+void GroupCacheMap(const char *filename,orbitdata *od,bool intransitive,
+                   intlisttable gens,int numgens)
+/* maps the group cache file filename into memory, checks that it is 
+   for od->n, intransitive and the given generators, and sets 
+   od->cosetreps and od->orbitrep to point to the data in it */
+{
+int fd,n;
+struct stat st;
+size_t size;
+int *data;
+n=od->n;
+size=(4+((size_t)numgens)*(n+1)+((size_t)(n+1))*(n+1)+(size_t)(n+1))*
+     sizeof(int);
+if((fd=open(filename,O_RDONLY))<0)
+   {
+   fprintf(stderr,"\nGroupCacheMap error: cannot open %s\n",filename);
+   exit(EXIT_FAILURE);
+   }
+if(fstat(fd,&st)!=0 || (size_t)st.st_size!=size
+   || (data=(int *)mmap(NULL,size,PROT_READ,MAP_SHARED,fd,0))==MAP_FAILED)
+   {
+   fprintf(stderr,"\nGroupCacheMap error: %s is not a group cache file "
+           "for this input\n",filename);
+   exit(EXIT_FAILURE);
+   }
+close(fd);
+if(data[0]!=GROUPCACHE_MAGIC || data[1]!=n || data[2]!=intransitive 
+   || data[3]!=numgens
+   || memcmp(data+4,TableRow(gens,n,1),((size_t)numgens)*(n+1)*sizeof(int))
+      !=0)
+   {
+   fprintf(stderr,"\nGroupCacheMap error: %s is not a group cache file "
+           "for this input\n",filename);
+   exit(EXIT_FAILURE);
+   }
+od->cosetreps=data+4+((size_t)numgens)*(n+1);
+od->orbitrep=od->cosetreps+((size_t)(n+1))*(n+1);
+}
+
+/* By default, the table of images of the (k-1)-subsets in adjcomb under
+   the coset reps is made if it needs at most DEFAULT_TABLE_MB megabytes */
+
+#define DEFAULT_TABLE_MB 256
+
+int main(int argc, char *argv[])
+{  
+int n,k,i,j,opt,nthreads,numshortreps,numgens;
+double tablemb,checkpointseconds,starttime;
+const char *checkpointfile,*groupcachefile;
+bool groupcachewrite;
+intlisttable gens; /* the generators of G for the group cache file */
+bool verbose,witness;
+intlist counterexample; /* for a job with the result 0 */
+searchstats stats; /* the statistics of the search for a job */
+unsigned long long *shortrepnodes; /* for the search for a job */
+bool result,server,strong,intransitive,withshortreps,withsym;
+orbitdata od; /* the data for the G-orbit on k-sets currently under
+                 consideration */
+intlist *shortreps; 
+workspace *ws; /* the storage for the sequential search */
+strongorbitdata sod; /* in strong mode, the data for the G-orbit on 
+                        tuples currently under consideration */
+strongworkspace *sws; /* the storage for the strong search */
+nthreads=1; /* default */
+tablemb=DEFAULT_TABLE_MB;
+server=false;
+strong=false;
+intransitive=false;
+withshortreps=false;
+withsym=false;
+checkpointfile=NULL;
+groupcachefile=NULL;
+groupcachewrite=false;
+gens=NULL; /* read in only with -g or -G */
+numgens=0;
+checkpointseconds=DEFAULT_CHECKPOINT_SECONDS;
+verbose=false;
+witness=false;
+progressseconds=0;
+while((opt=getopt(argc,argv,"t:m:sSidc:C:vp:wb:o:ye:g:G:"))!=-1)
+   switch(opt)
+      {
+      case 't':
+         nthreads=atoi(optarg);
+         if(nthreads<=0)
+            /* use all the available processors */
+            nthreads=(int)sysconf(_SC_NPROCESSORS_ONLN);
+         if(nthreads<=0)
+            nthreads=1;
+         break;
+      case 'm':
+         tablemb=atof(optarg);
+         break;
+      case 's':
+         server=true;
+         break;
+      case 'S':
+         strong=true;
+         break;
+      case 'i':
+         intransitive=true;
+         break;
+      case 'd':
+         withshortreps=true;
+         break;
+      case 'c':
+         checkpointfile=optarg;
+         break;
+      case 'C':
+         checkpointseconds=atof(optarg);
+         break;
+      case 'v':
+         verbose=true;
+         break;
+      case 'p':
+         progressseconds=atof(optarg);
+         break;
+      case 'w':
+         witness=true;
+         break;
+      case 'y':
+         withsym=true;
+         break;
+      case 'g':
+         groupcachefile=optarg;
+         groupcachewrite=false;
+         break;
+      case 'G':
+         groupcachefile=optarg;
+         groupcachewrite=true;
+         break;
+      case 'e':
+         if(strcmp(optarg,"scan")==0)
+            engine=ENGINE_SCAN;
+         else if(strcmp(optarg,"count")==0)
+            engine=ENGINE_COUNT;
+         else if(strcmp(optarg,"scalar")==0)
+            engine=ENGINE_SCALAR;
+         else
+            {
+            fprintf(stderr,"\n-e must be scan, count or scalar\n");
+            exit(EXIT_FAILURE);
+            }
+         break;
+      case 'b':
+         if(strcmp(optarg,"first")==0)
+            branchstrategy=BRANCH_FIRST;
+         else if(strcmp(optarg,"last")==0)
+            branchstrategy=BRANCH_LAST;
+         else if(strcmp(optarg,"cover")==0)
+            branchstrategy=BRANCH_COVER;
+         else
+            {
+            fprintf(stderr,"\n-b must be first, last or cover\n");
+            exit(EXIT_FAILURE);
+            }
+         break;
+      case 'o':
+         if(strcmp(optarg,"up")==0)
+            partstrategy=PARTS_UP;
+         else if(strcmp(optarg,"down")==0)
+            partstrategy=PARTS_DOWN;
+         else if(strcmp(optarg,"small")==0)
+            partstrategy=PARTS_SMALL;
+         else if(strcmp(optarg,"large")==0)
+            partstrategy=PARTS_LARGE;
+         else
+            {
+            fprintf(stderr,"\n-o must be up, down, small or large\n");
+            exit(EXIT_FAILURE);
+            }
+         break;
+      default:
+         fprintf(stderr,
+            "\nusage: %s [-t nthreads] [-m tablemb] [-s] [-S] [-i] [-d] "
+            "[-c file] [-C seconds] [-v] [-p seconds] [-w] [-b branch] "
+            "[-o partorder] [-y] [-e engine] [-g file] [-G file]\n",argv[0]);
+         exit(EXIT_FAILURE);
+      }
+if(checkpointfile!=NULL)
+   {
+   if(server || strong || nthreads>1)
+      {
+      fprintf(stderr,"\n-c is only for a single sequential search\n");
+      exit(EXIT_FAILURE);
+      }
+   signal(SIGTERM,CheckpointSignal);
+   signal(SIGINT,CheckpointSignal);
+   }
+ReadInput();
+if(!ReadInt(&n) || !ReadInt(&k) || (k<2) || (k>n))
+   {
+   fprintf(stderr,"\nbad input: must have 2<=k<=n\n");
+   exit(EXIT_FAILURE);
+   }
+if(strong)
+   {
+   if(k>n-1)
+      {
+      fprintf(stderr,"\nbad input: must have 2<=k<=n-1 in strong mode\n");
+      exit(EXIT_FAILURE);
+      }
+   sod.n=n;
+   sod.k=k;
+   /* Now handle the job, or, in server mode, each job until the end of 
+      the input, where a job is given by the tuples of an orbit followed 
+      by the shortreps. */
+   for(;;)
+      {
+      if((sod.tuples=TuplesRead(n,k,&sod.numtuples))==NULL)
+         {
+         if(!server)
+            {
+            fprintf(stderr,"\nbad input: no orbit given\n");
+            exit(EXIT_FAILURE);
+            }
+         break;
+         }
+      StrongOrbitIndex(&sod);
+      sws=NewStrongWorkspace(n,k,sod.numtuples);
+      shortreps=ShortrepsRead(&numshortreps);
+      result=SequentialStrongTransversalProperty(&sod,shortreps,
+                                                 numshortreps,sws);
+      printf("%d\n",result);
+      fflush(stdout);
+      for(i=0;i<numshortreps;i++)
+         free(shortreps[i]);
+      free(shortreps);
+      FreeStrongWorkspace(sws);
+      free(sod.bypoint);
+      free(sod.bypointstart);
+      free(sod.tuples);
+      if(!server)
+         break;
+      }
+   exit(EXIT_SUCCESS);
+   }
+od.n=n;
+od.k=k;
+vectorkernel=false;
+#ifdef HAVE_AVX2_KERNEL
+if(engine==ENGINE_SCAN && k<32)
+   {
+   __builtin_cpu_init();
+   vectorkernel=__builtin_cpu_supports("avx2");
+   }
+#endif
+if(groupcachefile!=NULL)
+   gens=GeneratorsRead(n,&numgens);
+if(groupcachefile!=NULL && !groupcachewrite)
+   GroupCacheMap(groupcachefile,&od,intransitive,gens,numgens);
+else
+   {
+   /* read in cosetreps, where the i-th coset rep maps the least point 
+      in the G-orbit of i to i (so, for G transitive, the coset reps are 
+      representatives for the right cosets in G of the stabilizer in G 
+      of 1) */
+   od.cosetreps=IntListTable(n,n);
+   for(i=1;i<=n;i++)
+      IntListReadInto(TableRow(od.cosetreps,n,i),n);
+   od.orbitrep=IntList(n);
+   if(intransitive)
+      /* read in the list of the least points in the G-orbits of 1,...,n */
+      IntListReadInto(od.orbitrep,n);
+   else
+      for(i=1;i<=n;i++)
+         od.orbitrep[i]=1;
+   if(groupcachefile!=NULL)
+      GroupCacheWrite(groupcachefile,&od,intransitive,gens,numgens);
+   }
+if(intransitive)
+   {
+   for(i=1;i<=n;i++)
+      if(od.orbitrep[i]<1 || od.orbitrep[i]>i 
+         || od.orbitrep[od.orbitrep[i]]!=od.orbitrep[i]
+         || TableRow(od.cosetreps,n,i)[od.orbitrep[i]]!=i)
+         {
+         fprintf(stderr,"\nbad input: invalid orbit reps\n");
+         exit(EXIT_FAILURE);
+         }
+   }
+ws=NewWorkspace(n,k);
+counterexample=IntList(n);
+/* Now handle the job, or, in server mode, each job until the end of 
+   the input, where a job is given by the adjacencies of the orbit reps
+   (just the adjacency of 1 when G is transitive) followed by
+   the shortreps (and with -y, the elements of G for SymmetryPrune). */
+while(AdjacenciesRead(&od,server,withshortreps))
+   {
+   /* make the table of images if it fits in tablemb megabytes */
+   od.images=NULL;
+   if((double)od.numimages<=(double)INT_MAX 
+      && (double)od.numimages*k*sizeof(int)<=tablemb*1048576.0)
+      MakeImages(&od);
+   /* number the k-subsets for the count engine if they fit too */
+   od.kset=NULL;
+   od.ksetsum=NULL;
+   if(engine==ENGINE_COUNT && k-1<=WORDBITS)
+      MakeKsets(&od,tablemb);
+   shortreps=ShortrepsRead(&numshortreps);
+   od.sym=NULL;
+   od.numsym=NULL;
+   if(withsym)
+      SymmetriesRead(&od,shortreps,numshortreps);
+   if((od.done=(atomic_bool *)malloc(((size_t)(numshortreps+1))*
+                                     sizeof(atomic_bool)))==NULL)
+      {
+      fprintf(stderr,"\nmain error: malloc failed\n"); 
+      exit(EXIT_FAILURE);
+      }
+   for(i=0;i<=numshortreps;i++)
+      atomic_init(&od.done[i],false);
+   atomic_init(&od.numdone,0);
+   if(od.adjshortrep!=NULL)
+      for(i=1;i<=od.numadj;i++)
+         for(j=1;j<=k;j++)
+            if(TableRow(od.adjshortrep,k,i)[j]<0 
+               || TableRow(od.adjshortrep,k,i)[j]>numshortreps)
+               {
+               fprintf(stderr,"\nbad input: invalid shortrep index\n");
+               exit(EXIT_FAILURE);
+               }
+   if(checkpointfile!=NULL)
+      ws->cp=NewCheckpoint(checkpointfile,checkpointseconds,&od,numshortreps,
+                           ws);
+   if((shortrepnodes=(unsigned long long *)malloc(((size_t)(numshortreps+1))*
+                              sizeof(unsigned long long)))==NULL)
+      {
+      fprintf(stderr,"\nmain error: malloc failed\n"); 
+      exit(EXIT_FAILURE);
+      }
+   starttime=Seconds();
+   progresslast=time(NULL);
+   if(nthreads>1)
+      result=ThreadedTransversalProperty(&od,shortreps,numshortreps,nthreads,
+                                         counterexample,&stats,shortrepnodes);
+   else
+      result=SequentialTransversalProperty(&od,shortreps,numshortreps,ws,
+                                           counterexample,&stats,
+                                           shortrepnodes);
+   if(ws->cp!=NULL)
       {
-      A[i]=k;
-      R[i]=false;
+      /* the search is finished, so its checkpoint is no longer needed */
+      remove(checkpointfile);
+      free(ws->cp);
+      ws->cp=NULL;
       }
-   for(i=1;i<=Length(shortrep);i++)
-      A[shortrep[i]]=i;
-   result=TransversalProperty(n,k,cosetreps,adj,comb,A,R,shortrep[1]);
-   if(!result)
-      /* k-set orbit defined by orbgraph does not provide a witness for k-et */
+   /* if result==false then the k-set orbit defined by orbgraph does not 
+      provide a witness for k-et */
+   printf("%d",result);
+   if(witness && !result)
+      for(i=1;i<=n;i++)
+         printf(" %d",counterexample[i]);
+   printf("\n");
+   if(verbose)
+      SearchStatsWrite(&stats,Seconds()-starttime,shortrepnodes,numshortreps);
+   fflush(stdout);
+   free(shortrepnodes);
+   for(i=0;i<numshortreps;i++)
+      free(shortreps[i]);
+   free(shortreps);
+   FreeSymmetries(&od,numshortreps);
+   free(od.images);
+   free(od.kset);
+   free(od.ksetsum);
+   free(od.done);
+   free(od.adjshortrep);
+   free(od.adjcomb);
+   free(od.numadjof);
+   free(od.adjfirst);
+   free(od.imagefirst);
+   if(!server)
       break;
    }
-printf("%d\n",result);
 exit(EXIT_SUCCESS);
 }
@@ -6,7 +6,8 @@
 #
 # To use these functions, first compile the program `tpexternal.c'
 # (if you want to make use of this external program which can greatly
-# speed up the computation of the k-ut and k-et properties).
+# speed up the computation of the k-ut and k-et properties), 
+# for example with:  cc -O2 -pthread -o tpexternal tpexternal.c
 #
 # Then set the default info level here to 0, 1, 2 or 3 as desired,
 # to determine how much extra information will be printed out.
@@ -14,7 +15,7 @@
 DeclareInfoClass("TRANSVERSALPROPERTIES_info");
 SetInfoLevel(TRANSVERSALPROPERTIES_info,2);
 
-TRANSVERSALPROPERTIES_tpexternal_maxnum:=1;
+TRANSVERSALPROPERTIES_tpexternal_maxnum:=infinity;
 # Set this global variable to 0 if you do *not* want to make use of
 # the external C program `tpexternal.c'.
 # 
@@ -22,12 +23,125 @@ TRANSVERSALPROPERTIES_tpexternal_maxnum:=1;
 # (which can greatly speed up the computation of k-ut and k-et),
 # then this global variable should be set to the maximum number
 # of "shortreps" to be handled by the external program for each "rep"
-# when computing k-ut or k-et. Usually, the value 1 is best.
+# when computing k-ut or k-et. Usually, the value  infinity  is best,
+# as the external program uses the shortreps whose searches it has 
+# completed to cut short the later searches, just as is done in GAP.
 
 TRANSVERSALPROPERTIES_tpexternal_exe:="/home/lsoicher/bin/tpexternal";
 # If you are using the external program `tpexternal.c', then you should
 # set this variable to the program's executable file.
 
+TRANSVERSALPROPERTIES_tpexternal_strong:=true;
+# If  TRANSVERSALPROPERTIES_tpexternal_maxnum>0,  then the external 
+# program is also used (in its strong mode) to compute strong k-ut, 
+# unless this global variable is set to `false'.
+
+TRANSVERSALPROPERTIES_tpexternal_threads:=1;
+# This is the number of threads used by the external program to
+# search (in parallel) the trees for the shortreps handled by it.
+# The value 0 means that all the available processors are used.
+
+TRANSVERSALPROPERTIES_tpexternal_tablemb:=256;
+# The external program precomputes a table of the images of the 
+# adjacency of vertex 1 of the orbit graph under the coset reps 
+# (which speeds up its search) when this table needs at most this many 
+# megabytes of memory. The value 0 means that this table is never made.
+
+TRANSVERSALPROPERTIES_tpexternal_server:=false;
+# Set this global variable to `true' to keep the external program 
+# running (in server mode, communicating through a pipe) while 
+# successive orbit reps for the same group and  k  are tested, 
+# so that the group data are sent and set up only once, 
+# instead of starting the external program for each orbit rep.
+
+TRANSVERSALPROPERTIES_tpexternal_binary:=false;
+# Set this global variable to `true' to write the input file for 
+# the external program in a binary format (which is quicker to write 
+# and to read than the text format, for large groups). This is not 
+# used when  TRANSVERSALPROPERTIES_tpexternal_server=true  or
+# TRANSVERSALPROPERTIES_tpexternal_pipes=true. 
+
+TRANSVERSALPROPERTIES_tpexternal_pipes:=false;
+# Set this global variable to `true' to send the input for each run 
+# of the external program straight to its standard input, and to read 
+# its result from its standard output, instead of going through 
+# files in  TRANSVERSALPROPERTIES_tmpdir  (which can be slow when 
+# this is on a shared filesystem).
+
+TRANSVERSALPROPERTIES_tpexternal_jobs:=1;
+# When this global variable is greater than 1, and the external 
+# program handles all the shortreps, then the orbit reps in 
+# UniversalTransversalProperty and ExistentialTransversalProperty 
+# are tested by running up to this many copies of the external 
+# program at once. The remaining runs are cancelled as soon as the 
+# answer is known (at the first failing rep for k-ut, and at the 
+# first witness for k-et). 
+
+TRANSVERSALPROPERTIES_tpexternal_progress:=0;
+# When this global variable is positive, the external program writes 
+# a report on the progress of its search (for computing k-ut or k-et)
+# to its standard error about every this many seconds. Statistics for 
+# each search of the external program are displayed at info level 3.
+
+TRANSVERSALPROPERTIES_tpexternal_branch:="first";
+TRANSVERSALPROPERTIES_tpexternal_partorder:="up";
+# These global variables give the search order of the external 
+# program (see its  -b  and  -o  options): the point to branch on 
+# ("first", "last" or "cover") and the order in which the parts are 
+# tried for it ("up", "down", "small" or "large"). This affects the 
+# time taken, but not the results (the number of nodes searched is 
+# given in the statistics, which can be used to compare the orders).
+
+TRANSVERSALPROPERTIES_branch:="last";
+TRANSVERSALPROPERTIES_partorder:="up";
+# These global variables give the search order of  TransversalProperty 
+# (the search in GAP, for the shortreps not handled by the external 
+# program), in the same way as for the external program: the point of 
+# R  to branch on ("last" the greatest, "first" the least, or "cover" 
+# a point completing the most  k-subsets  in the orbit to transversals) 
+# and the order in which the parts are tried for it ("up", "down", 
+# "small" or "large"). The number of nodes searched is added to 
+# TRANSVERSALPROPERTIES_nodes,  which can be used to compare the orders.
+
+TRANSVERSALPROPERTIES_tpexternal_engine:="scan";
+# This global variable gives the engine with which the external 
+# program tests the k-subsets through each new point in its search 
+# (see its  -e  option): "scan", "count" or "scalar". The "count" 
+# engine keeps counts for each k-subset in the orbit, at the cost of 
+# numbering these k-subsets first (in up to 
+# TRANSVERSALPROPERTIES_tpexternal_tablemb  megabytes), which makes 
+# each step of the search faster than the "scalar" one, but when the
+# CPU supports AVX2 the (vectorised) "scan" engine is faster still. 
+# The results are the same.
+
+TRANSVERSALPROPERTIES_tpexternal_symmetry:=0;
+# When this global variable is positive, the external program is also
+# given, for each shortrep, elements of the subgroup of G fixing each 
+# point of the shortrep (all of its non-identity elements if it has at 
+# most this many elements, and otherwise a small generating set), 
+# which it uses to prune its searches (see its  -y  option). This 
+# can only help when these subgroups are large.
+
+TRANSVERSALPROPERTIES_cache_orbgraphs:=false;
+# The lex-least set representatives, set-stabilizer sizes and least 
+# images of sets computed for a group are kept with the group (see 
+# TransversalPropertiesGroupData),  so that they are computed only 
+# once for successive values of  k  and for the different properties. 
+# Set this global variable to `true' to keep also the orbit adjacency 
+# for each orbit rep tested (so that, for example, testing k-ut and 
+# then k-et for the same group does not compute these again), at the 
+# cost of keeping all of them in memory. 
+
+TRANSVERSALPROPERTIES_tpexternal_groupcache:=fail;
+# Set this global variable to a directory name (as a string) to keep 
+# the group data (the coset reps and orbit reps) for the external 
+# program in files in that directory, one for each group (given by 
+# its generators), which the external program maps into memory 
+# instead of reading in these data (see its  -g  and  -G  options). 
+# The files are kept between GAP sessions, and the copies of the 
+# external program running at once on a machine share one copy of 
+# the data for the same group.
+
 # Then in a GAP session, use the `Read' command to read in this 
 # file `transversalproperties.g', and you should be ready to go!
 
@@ -37,6 +151,34 @@ TRANSVERSALPROPERTIES_tmpdir:=DirectoryTemporary();
 # This is for files to communicate with the external program's
 # executable file. 
 
+TRANSVERSALPROPERTIES_tpexternal_session:=fail;
+# When  TRANSVERSALPROPERTIES_tpexternal_server=true,  this is the
+# record of the current session with the external program.
+
+TRANSVERSALPROPERTIES_batch_results:=[];
+# This is used by  TransversalPropertiesBatch  when reading in the 
+# results file of a batch.
+
+TRANSVERSALPROPERTIES_tpexternal_statistics:=fail;
+# If this is set to a list, then the record of the statistics of each 
+# search by the external program for k-ut or k-et (as given by its 
+# option -v) is added to this list (as is done by the benchmarks in 
+# the directory  bench). 
+
+TRANSVERSALPROPERTIES_nodes:=0;
+# The number of nodes (recursive calls) searched by  TransversalProperty 
+# is added to this global variable, which can be reset to 0 to count 
+# these for a computation. 
+
+TRANSVERSALPROPERTIES_et_lazy:=false;
+# Set this global variable to `true' to have 
+# ExistentialTransversalProperty  make only the candidate witnesses 
+# (see  ExistentialTransversalPropertyCandidates),  instead of all 
+# the orbit reps of k-subsets,  and test these in turn (largest 
+# stabilizer first), each only when it is reached, stopping at the 
+# first witness. This is much faster for large groups, but the 
+# shortcut for  G  k-homogeneous is then not taken. 
+
 TRANSVERSALPROPERTIES_testmode:=false;
 # Normally this global variable should be set to `false',
 # but if set to `true' then certain theoretical shortcuts are *not* 
@@ -44,37 +186,643 @@ TRANSVERSALPROPERTIES_testmode:=false;
 
 LoadPackage("grape");
 
-PrintStreamTpexternalInput:=function(stream,G,k,orbgraph,shortreps)
+SetRank := function(x,n)
+#
+# Suppose  x  is a subset of  [1..n].  Then this function returns the 
+# position of  x  in  Combinations([1..n],Length(x)),  that is, the 
+# rank (from 1) of  x  in the lex-ordered list of the subsets of  [1..n] 
+# of size  Length(x).
+#
+local k,j,r;
+k:=Length(x);
+r:=Binomial(n,k);
+for j in [1..k] do
+   r:=r-Binomial(n-x[j],k-j+1);
+od;
+return r;
+end;
+
+SmallestImageSetCache := function(G)
+#
+# Returns a new (empty) cache for the function  CachedSmallestImageSet,
+# for the permutation group  G.
+#
+return rec(G:=G,n:=LargestMovedPoint(G),dict:=NewDictionary(1,true));
+end;
+
+CachedSmallestImageSet := function(cache,x)
+#
+# Returns  SmallestImageSet(cache.G,x),  where  cache  was made by 
+# SmallestImageSetCache,  and  x  is a subset of  [1..cache.n].
+# The results are remembered in  cache,  keyed by the rank of  x, 
+# so all the sets given for the same cache must have the same size. 
 #
-# Prints the input data for tpexternal on the given output stream. 
+local r,y;
+r:=SetRank(x,cache.n);
+y:=LookupDictionary(cache.dict,r);
+if y=fail then
+   y:=SmallestImageSet(cache.G,x);
+   AddDictionary(cache.dict,r,y);
+fi;
+return y;
+end;
+
+OrbAdjacency := function(G,rep)
+#
+# Suppose  G  is a permutation group on  [1..n],
+# where  n:=LargestMovedPoint(G), and  rep  is a 
+# k-subset  of  [1..n],  with  k>0. 
+# 
+# Then this function returns a record representing the  G-orbit  of 
+# rep,  for use in place of  OrbGraph(G,rep)  (but without making 
+# the vertex set of all the (k-1)-subsets of  [1..n]).  The adjacencies
+# are computed (and stored in the record) only as they are needed, 
+# by  OrbAdjacencySets.
 #
-local n,i,j,adj,cosetreps,rt;
+local n,k,orb,orbitrep;
+if not (IsPermGroup(G) and IsSet(rep)) then
+   Error("usage: OrbAdjacency( <PermGrp>, <Set> )");
+fi;
 n:=LargestMovedPoint(G);
-rt:=RightTransversal(G,Stabilizer(G,1));
+k:=Length(rep);
+if not (k>0 and IsSubset([1..n],rep)) then
+   Error("<rep> must be a non-empty subset of [1..LargestMovedPoint(<G>)]");
+fi;
+orbitrep:=[];
+for orb in Orbits(G,[1..n]) do
+   orbitrep{orb}:=ListWithIdenticalEntries(Length(orb),Minimum(orb));
+od;
+return rec(G:=G,rep:=rep,n:=n,k:=k,orbitrep:=orbitrep,adj:=[]);
+end;
+
+OrbAdjacencySets := function(orbadj,x)
+#
+# Suppose  orbadj  was made by  OrbAdjacency(G,rep)  or by 
+# OrbGraph(G,rep),  and  x  is in  [1..n].  Then this function returns 
+# the set of the  (k-1)-subsets  y  of  [1..n]  such that  Union(y,[x])
+# is in the  G-orbit  of  rep.
+#
+# For  x  the least point in its  G-orbit,  these are obtained from 
+# the orbits of the stabilizer of  x  on the  k-sets  in the  G-orbit 
+# of  rep  containing  x,  and for other  x  they are the images of 
+# those for the least point in the  G-orbit  of  x. 
+#
+local G,o,c,ks,z,stab;
+if IsGraph(orbadj) then
+   return orbadj.names{Adjacency(orbadj,x)};
+fi;
+if not IsBound(orbadj.adj[x]) then
+   G:=orbadj.G;
+   o:=orbadj.orbitrep[x];
+   if o<>x then
+      c:=RepresentativeAction(G,o,x);
+      orbadj.adj[x]:=Set(OrbAdjacencySets(orbadj,o),y->OnSets(y,c));
+   else
+      stab:=Stabilizer(G,x);
+      ks:=[];
+      for z in orbadj.rep do
+         if orbadj.orbitrep[z]=o then
+            c:=RepresentativeAction(G,z,x);
+            UniteSet(ks,Orbit(stab,OnSets(orbadj.rep,c),OnSets));
+         fi;
+      od;
+      orbadj.adj[x]:=Set(ks,K->Difference(K,[x]));
+   fi;
+fi;
+return orbadj.adj[x];
+end;
+
+TpexternalBinaryString:=function(list,optional...)
+#
+# Returns the string encoding the integers in  list  in the binary 
+# format read by tpexternal, that is, each integer as 4 bytes (or as
+# optional[1]  bytes, which is 8 for the ranks of (k-1)-subsets), 
+# least significant byte first (negative integers in two's complement).
+#
+local str,x,i,bytes;
+if Length(optional)>0 then
+   bytes:=optional[1];
+else
+   bytes:=4;
+fi;
+str:=[];
+for x in list do
+   if x<0 then
+      x:=x+2^(8*bytes);
+   fi;
+   for i in [1..bytes] do
+      Add(str,CHAR_INT(RemInt(x,256)));
+      x:=QuoInt(x,256);
+   od;
+od;
+ConvertToStringRep(str);
+return str;
+end;
+
+PrintStreamTpexternalList:=function(stream,list,binary,optional...)
+#
+# Prints the integer list  list  on the given output stream, in the 
+# form read by tpexternal: the length of  list,  followed by its elements.
+# If  binary=true  then this is done in the binary format, with each 
+# element given by  optional[1]  bytes (default 4). 
+#
+if binary then
+   WriteAll(stream,TpexternalBinaryString([Length(list)]));
+   WriteAll(stream,CallFuncList(TpexternalBinaryString,
+      Concatenation([list],optional)));
+else
+   WriteAll(stream,Concatenation("\n",String(Length(list)),"\n",
+      JoinStringsWithSeparator(List(list,String)," ")));
+fi;
+end;
+
+TpexternalGroupCacheFile:=function(G)
+#
+# Returns the name of the group cache file for  G  in the directory 
+# TRANSVERSALPROPERTIES_tpexternal_groupcache,  made from the degree 
+# of  G  and a hash of its generators. (The external program checks 
+# that the generators given to it are those in the file.)
+#
+local n,gens,h,g,i;
+n:=LargestMovedPoint(G);
+gens:=GeneratorsOfGroup(G);
+h:=0;
+for g in gens do
+   for i in [1..n] do
+      h:=(h*(n+1)+i^g) mod 1000000007;
+   od;
+od;
+return Filename(Directory(TRANSVERSALPROPERTIES_tpexternal_groupcache),
+   Concatenation("tpgroup_",String(n),"_",String(Length(gens)),"_",
+      String(h),".dat"));
+end;
+
+PrintStreamTpexternalGroup:=function(stream,G,k,binary,optional...)
+#
+# Prints the group data (n, k and the coset reps, and, if  G  is not 
+# transitive on  [1..n],  the list of orbit reps) for tpexternal 
+# on the given output stream, in the binary format if  binary=true.
+# (The binary format must be introduced by the magic string "TPB1".)
+#
+# The optional parameter  optional[1]  is the list of command-line 
+# arguments for tpexternal: with  "-g"  in it, only  n,  k  and the 
+# generators of  G  are printed (as the rest is in the group cache 
+# file), and with  "-G"  in it, n  and  k  are followed by the 
+# generators and then the rest of the group data.
+#
+local n,i,j,cosetreps,rt,orb,orbitreps,args,g;
+n:=LargestMovedPoint(G);
+if Length(optional)>0 then
+   args:=optional[1];
+else
+   args:=[];
+fi;
+if "-g" in args or "-G" in args then
+   if binary then
+      WriteAll(stream,TpexternalBinaryString([n,k]));
+   else
+      WriteAll(stream,Concatenation(String(n)," ",String(k)));
+   fi;
+   for g in GeneratorsOfGroup(G) do
+      PrintStreamTpexternalList(stream,List([1..n],j->j^g),binary);
+   od;
+   PrintStreamTpexternalList(stream,[],binary);
+   if "-g" in args then
+      return;
+   fi;
+fi;
 cosetreps:=[];
-for i in [1..n] do
-   cosetreps[1^rt[i]]:=rt[i]; 
+orbitreps:=[];
+for orb in Orbits(G,[1..n]) do
+   rt:=RightTransversal(G,Stabilizer(G,Minimum(orb)));
+   for i in [1..Length(rt)] do
+      cosetreps[Minimum(orb)^rt[i]]:=rt[i]; 
+   od;
+   orbitreps{orb}:=ListWithIdenticalEntries(Length(orb),Minimum(orb));
 od;
-# so, for j=1,...,n, cosetreps[j] maps 1 to j
-PrintTo(stream,n," ",k);
+# so, for j=1,...,n, cosetreps[j] maps orbitreps[j] (the least point 
+# in the orbit of j) to j
+if not "-G" in args then
+   if binary then
+      WriteAll(stream,TpexternalBinaryString([n,k]));
+   else
+      WriteAll(stream,Concatenation(String(n)," ",String(k)));
+   fi;
+fi;
 for i in [1..n] do 
-   AppendTo(stream,"\n",n,"\n"); 
-   for j in [1..n] do 
-      AppendTo(stream,j^cosetreps[i]," ");
+   PrintStreamTpexternalList(stream,List([1..n],j->j^cosetreps[i]),binary);
+od;
+if not IsTransitive(G,[1..n]) then
+   PrintStreamTpexternalList(stream,orbitreps,binary);
+fi;
+end;
+
+TpexternalSymmetries:=function(G,shortrep)
+#
+# Returns a list of elements of the subgroup  H  of  G  fixing each 
+# point of  shortrep:  all the non-identity elements of  H  if 
+# Size(H)<=TRANSVERSALPROPERTIES_tpexternal_symmetry,  and otherwise
+# a small generating set of  H.
+#
+local H;
+H:=Stabilizer(G,shortrep,OnTuples);
+if Size(H)<=TRANSVERSALPROPERTIES_tpexternal_symmetry then
+   return Filtered(AsList(H),g->not IsOne(g));
+fi;
+return SmallGeneratingSet(H);
+end;
+
+PrintStreamTpexternalJob:=function(stream,G,orbgraph,shortreps,binary,
+   optional...)
+#
+# Prints the data for a job of tpexternal (the adjacency in  orbgraph
+# (made by  OrbAdjacency  or  OrbGraph)  of the least point in each 
+# G-orbit  on  [1..n],  in increasing order of these points, and the 
+# shortreps) on the given output stream, in the binary format if 
+# binary=true.
+#
+# If  Length(shortreps)>1,  then each adjacency is followed by the
+# list of the positions in  shortreps  of the least representatives 
+# of the (k-1)-subsets of each k-subset  K  in the adjacency (first 
+# that of  K  minus the point, and then those of  K  minus each 
+# element of the (k-1)-subset, in increasing order), or 0 for 
+# a representative not in  shortreps,  for use by tpexternal with 
+# the option -d. The optional parameter  optional[1]  (default: a new 
+# cache) must be a cache made by  SmallestImageSetCache(G),  used for 
+# these least representatives. 
+#
+# When  TRANSVERSALPROPERTIES_tpexternal_symmetry>0,  the shortreps 
+# are followed by the elements given by  TpexternalSymmetries 
+# for each of them, for tpexternal with the option -y.
+#
+local n,s,o,adj,ids,c,K,x,cache,g;
+n:=LargestMovedPoint(G);
+if Length(optional)>0 then
+   cache:=optional[1];
+else
+   cache:=SmallestImageSetCache(G);
+fi;
+for o in Set(Orbits(G,[1..n]),Minimum) do
+   adj:=OrbAdjacencySets(orbgraph,o);
+   # the ranks can exceed 2^31 for large n, and are given by 8 bytes
+   PrintStreamTpexternalList(stream,List(adj,y->SetRank(y,n)),binary,8);
+   if Length(shortreps)>1 then
+      ids:=[];
+      for c in adj do
+         K:=Union(c,[o]);
+         Add(ids,CachedSmallestImageSet(cache,c));
+         for x in c do 
+            Add(ids,CachedSmallestImageSet(cache,Difference(K,[x])));
+         od;
+      od;
+      ids:=List(ids,function(x) 
+         local pos;
+         pos:=Position(shortreps,x);
+         if pos=fail then
+            return 0;
+         fi;
+         return pos;
+         end);
+      PrintStreamTpexternalList(stream,ids,binary);
+   fi;
+od;
+for s in shortreps do
+   PrintStreamTpexternalList(stream,s,binary);
+od;
+PrintStreamTpexternalList(stream,[],binary); # end of shortreps
+if TRANSVERSALPROPERTIES_tpexternal_symmetry>0 then
+   for s in shortreps do
+      for g in TpexternalSymmetries(G,s) do 
+         PrintStreamTpexternalList(stream,List([1..n],j->j^g),binary);
+      od;
+      PrintStreamTpexternalList(stream,[],binary); # end of elements for s
    od;
+fi;
+end;
+
+PrintStreamTpexternalInput:=function(stream,G,k,orbgraph,shortreps)
+#
+# Prints the input data for tpexternal on the given output stream, 
+# in the binary format if  TRANSVERSALPROPERTIES_tpexternal_binary=true.
+#
+local binary;
+binary:=TRANSVERSALPROPERTIES_tpexternal_binary;
+if binary then
+   WriteAll(stream,"TPB1");
+fi;
+PrintStreamTpexternalGroup(stream,G,k,binary);
+PrintStreamTpexternalJob(stream,G,orbgraph,shortreps,binary);
+end;
+
+PrintStreamTpexternalStrongJob:=function(stream,orb,shortreps,binary)
+#
+# Prints the data for a job of tpexternal in strong mode (the tuples 
+# [T,U] in the orbit given by  orb,  made by  StrongOrbitIndex,  each 
+# as the list  Concatenation(T,U),  and the shortreps) on the given 
+# output stream, in the binary format if binary=true. 
+#
+local p,s;
+for p in [1,orb.k+2..Length(orb.points)-orb.k] do
+   PrintStreamTpexternalList(stream,orb.points{[p..p+orb.k]},binary);
 od;
-adj:=Adjacency(orbgraph,1);
-AppendTo(stream,"\n",Length(adj),"\n"); 
-for i in adj do 
-   AppendTo(stream,i-n," ");
+PrintStreamTpexternalList(stream,[],binary); # end of orb 
+for s in shortreps do
+   PrintStreamTpexternalList(stream,s,binary);
+od;
+PrintStreamTpexternalList(stream,[],binary); # end of data
+end;
+
+TpexternalArgs:=function(G,numshortreps)
+#
+# Returns the list of command-line arguments for tpexternal, 
+# as determined by the global variables above (and the info level), 
+# by whether  G  is transitive on  [1..LargestMovedPoint(G)],  and by 
+# the number  numshortreps  of shortreps in each job.
+#
+local args;
+args:=["-t",String(TRANSVERSALPROPERTIES_tpexternal_threads),
+       "-m",String(TRANSVERSALPROPERTIES_tpexternal_tablemb),"-w"];
+if not IsTransitive(G,[1..LargestMovedPoint(G)]) then
+   Add(args,"-i");
+fi;
+if numshortreps>1 then
+   Add(args,"-d");
+fi;
+if InfoLevel(TRANSVERSALPROPERTIES_info)>=3 
+   or IsList(TRANSVERSALPROPERTIES_tpexternal_statistics) then
+   Add(args,"-v");
+fi;
+if TRANSVERSALPROPERTIES_tpexternal_progress>0 then
+   Append(args,["-p",String(TRANSVERSALPROPERTIES_tpexternal_progress)]);
+fi;
+if TRANSVERSALPROPERTIES_tpexternal_branch<>"first" then
+   Append(args,["-b",TRANSVERSALPROPERTIES_tpexternal_branch]);
+fi;
+if TRANSVERSALPROPERTIES_tpexternal_partorder<>"up" then
+   Append(args,["-o",TRANSVERSALPROPERTIES_tpexternal_partorder]);
+fi;
+if TRANSVERSALPROPERTIES_tpexternal_engine<>"scan" then
+   Append(args,["-e",TRANSVERSALPROPERTIES_tpexternal_engine]);
+fi;
+if TRANSVERSALPROPERTIES_tpexternal_symmetry>0 then
+   Add(args,"-y");
+fi;
+if TRANSVERSALPROPERTIES_tpexternal_groupcache<>fail then
+   if IsExistingFile(TpexternalGroupCacheFile(G)) then
+      Append(args,["-g",TpexternalGroupCacheFile(G)]);
+   else
+      Append(args,["-G",TpexternalGroupCacheFile(G)]);
+   fi;
+fi;
+return args;
+end;
+
+TpexternalOutputLines:=function(args)
+#
+# Returns the number of lines written by tpexternal for each job when 
+# run with the command-line arguments in the list  args. 
+#
+if "-v" in args then
+   return 2; # the result, and the statistics of the search
+fi;
+return 1;
+end;
+
+TpexternalReadOutput:=function(stream,args)
+#
+# Reads (waiting as necessary) the output for a job from the 
+# input/output stream  stream  to tpexternal, which is running with 
+# the command-line arguments in the list  args,  and returns this
+# output as a string (or  fail  if it is not available).
+#
+local output,i,line;
+output:="";
+for i in [1..TpexternalOutputLines(args)] do
+   line:=ReadAllLine(stream,true);
+   if line=fail then
+      return fail;
+   fi;
+   Append(output,line);
+od;
+return output;
+end;
+
+TpexternalResult:=function(output)
+#
+# Returns the result (the integer 0 or 1) given by the first line of 
+# the string  output  written by tpexternal for a job, or  fail  if 
+# there is no such result. The statistics of the search, if given
+# by a later line in  output,  are displayed at info level 3 (and 
+# added to  TRANSVERSALPROPERTIES_tpexternal_statistics  if this is 
+# a list).
+#
+local lines,line;
+if output=fail then
+   return fail;
+fi;
+lines:=Filtered(SplitString(output,"\n"),x->x<>"");
+if lines=[] then
+   return fail;
+fi;
+for line in lines{[2..Length(lines)]} do
+   if StartsWith(line,"rec(") then
+      Info(TRANSVERSALPROPERTIES_info,3,
+         "Statistics of the search by tpexternal: ",line);
+      if IsList(TRANSVERSALPROPERTIES_tpexternal_statistics) then
+         Add(TRANSVERSALPROPERTIES_tpexternal_statistics,
+            EvalString(line));
+      fi;
+   fi;
 od;
-for i in [1..Length(shortreps)] do
-   AppendTo(stream,"\n",Length(shortreps[i]),"\n");
-   for j in shortreps[i] do 
-      AppendTo(stream,j," ");
+return Int(SplitString(lines[1],""," ")[1]);
+end;
+
+TpexternalCounterexample:=function(output)
+#
+# Returns the counterexample (an ordered partition, as a list of sets) 
+# given with the result 0 in the first line of the string  output 
+# written by tpexternal for a job (see the option -w of tpexternal), 
+# or  fail  if there is none.
+#
+local words;
+words:=SplitString(SplitString(output,"\n")[1],""," ");
+if Length(words)<2 or words[1]<>"0" then
+   return fail;
+fi;
+return GRAPE_NumbersToSets(List(words{[2..Length(words)]},Int));
+end;
+
+TpexternalProcess:=function(args)
+#
+# Starts tpexternal with the command-line arguments in the list  args,
+# and returns an input/output stream to it.
+#
+local stream;
+stream:=InputOutputLocalProcess(DirectoryCurrent(),
+   TRANSVERSALPROPERTIES_tpexternal_exe,args);
+if stream=fail then
+   Error("TpexternalProcess: error starting ",
+      TRANSVERSALPROPERTIES_tpexternal_exe);
+fi;
+return stream;
+end;
+
+TpexternalRun:=function(args,print)
+#
+# Runs tpexternal once, with the command-line arguments in the list  args,
+# and returns its output as a string (or  fail  if there is none).
+# The input is written by the call  print(stream,binary),  where  binary
+# is  true  iff the binary format is to be used (in which case  print 
+# must first write the magic string "TPB1").
+# 
+# If  TRANSVERSALPROPERTIES_tpexternal_pipes=true  then the input and 
+# output go through pipes, and otherwise through files in 
+# TRANSVERSALPROPERTIES_tmpdir.
+#
+local in_file,in_stream,out_file,out_stream,status,result,stream;
+if TRANSVERSALPROPERTIES_tpexternal_pipes then
+   stream:=TpexternalProcess(args);
+   print(stream,false);
+   result:=TpexternalReadOutput(stream,args);
+   CloseStream(stream);
+   return result;
+fi;
+in_file:=Filename(TRANSVERSALPROPERTIES_tmpdir,"in_file");
+out_file:=Filename(TRANSVERSALPROPERTIES_tmpdir,"out_file");
+RemoveFile(in_file);  # in case there is a leftover copy
+RemoveFile(out_file); # in case there is a leftover copy
+in_stream:=OutputTextFile(in_file,false);
+if in_stream=fail then
+    Error("TpexternalRun: error opening output text stream using file ",
+       in_file); 
+fi;
+SetPrintFormattingStatus(in_stream,false);
+print(in_stream,TRANSVERSALPROPERTIES_tpexternal_binary);
+CloseStream(in_stream);
+in_stream:=InputTextFile(in_file);
+if in_stream=fail then
+   Error("TpexternalRun: error opening input text stream using file ",
+      in_file);
+fi;
+out_stream:=OutputTextFile(out_file,false);
+if out_stream=fail then
+    Error("TpexternalRun: error opening output text stream using file ",
+       out_file);
+fi;
+SetPrintFormattingStatus(out_stream,false);
+status:=GRAPE_Exec(TRANSVERSALPROPERTIES_tpexternal_exe,args,
+   in_stream,out_stream);
+if status<>0 then
+  Error("TpexternalRun: exit code ",status," returned by tpexternal;\n",
+   "returned results may be wrong");
+fi;
+CloseStream(out_stream);
+out_stream:=InputTextFile(out_file);
+result:=ReadAll(out_stream);
+CloseStream(in_stream); 
+CloseStream(out_stream); 
+RemoveFile(in_file);
+RemoveFile(out_file);
+return result;
+end;
+
+TpexternalParallelReps:=function(G,reps,shortreps,cache,stopresult)
+#
+# Tests the  G-orbits  of the k-sets in  reps  as  tpmain  does (with 
+# tpexternal handling all the  shortreps),  running up to 
+# TRANSVERSALPROPERTIES_tpexternal_jobs  copies of tpexternal at once.
+# As soon as the result for some rep is  stopresult,  the runs still 
+# going are cancelled, and that rep is returned. If there is no such 
+# rep, then  fail  is returned. 
+#
+local n,k,args,running,next,job,line,result,found,progress,rep,numlines;
+n:=LargestMovedPoint(G);
+k:=Length(reps[1]);
+args:=TpexternalArgs(G,Length(shortreps));
+numlines:=TpexternalOutputLines(args);
+running:=[];
+next:=1;
+found:=fail;
+while found=fail and (next<=Length(reps) or running<>[]) do
+   while next<=Length(reps) 
+      and Length(running)<TRANSVERSALPROPERTIES_tpexternal_jobs do
+      rep:=reps[next];
+      next:=next+1;
+      Info(TRANSVERSALPROPERTIES_info,2,
+         "TpexternalParallelReps: starting test of orbit of: ",rep);
+      job:=rec(rep:=rep,stream:=TpexternalProcess(args),line:="");
+      PrintStreamTpexternalGroup(job.stream,G,k,false,args);
+      PrintStreamTpexternalJob(job.stream,G,CachedOrbAdjacency(G,rep),shortreps,
+         false,cache);
+      Add(running,job);
    od;
+   progress:=false;
+   for job in ShallowCopy(running) do
+      line:=ReadAllLine(job.stream);
+      if line<>fail then
+         Append(job.line,line);
+      fi;
+      if Number(job.line,c->c='\n')>=numlines then
+         progress:=true;
+         result:=TpexternalResult(job.line);
+         if result<>0 and result<>1 then 
+            Error("TpexternalParallelReps: invalid result");
+         fi;
+         CloseStream(job.stream);
+         Remove(running,PositionProperty(running,x->IsIdenticalObj(x,job)));
+         if (result=1)=stopresult then
+            found:=job.rep;
+            break;
+         fi;
+      elif line=fail and IsEndOfStream(job.stream) then
+         Error("TpexternalParallelReps: result unavailable");
+      fi;
+   od;
+   if not progress then
+      MicroSleep(1000);
+   fi;
+od;
+for job in running do
+   # cancel the runs still going
+   CloseStream(job.stream);
 od;
-AppendTo(stream,"\n",0,"\n"); # end of data
+return found;
+end;
+
+TpexternalCloseSession:=function()
+#
+# Ends the current session (if any) with tpexternal running in server mode.
+#
+if TRANSVERSALPROPERTIES_tpexternal_session<>fail then
+   CloseStream(TRANSVERSALPROPERTIES_tpexternal_session.stream);
+   TRANSVERSALPROPERTIES_tpexternal_session:=fail;
+fi;
+end;
+
+InstallAtExit(TpexternalCloseSession);
+
+TpexternalSession:=function(G,k,args)
+#
+# Returns an input/output stream to tpexternal running in server mode,
+# with the further command-line arguments in the list  args,
+# to which the group data for  G  and  k  have been sent. 
+# The current session is reused if it was started for (the same 
+# object)  G  and for  k  and  args,  and otherwise a new session 
+# is started.
+#
+local session,stream;
+session:=TRANSVERSALPROPERTIES_tpexternal_session;
+if session<>fail then
+   if IsIdenticalObj(session.G,G) and session.k=k and session.args=args then
+      return session.stream;
+   fi;
+   TpexternalCloseSession();
+fi;
+stream:=TpexternalProcess(Concatenation(["-s"],args));
+PrintStreamTpexternalGroup(stream,G,k,false,args);
+TRANSVERSALPROPERTIES_tpexternal_session:=
+   rec(G:=G,k:=k,args:=args,stream:=stream);
+return stream;
 end;
 
 LeastSetRepresentatives := function(G,k)
@@ -136,10 +884,93 @@ return Graph(G,Concatenation([1..n],Combinations([1..n],k-1)),
    true);
 end;
 
-TransversalProperty := function(G,k,orbgraph,A,R,newpoint,done)
+if not IsBound(TransversalPropertiesGroupData) then
+   DeclareAttribute("TransversalPropertiesGroupData",IsPermGroup,"mutable");
+   InstallMethod(TransversalPropertiesGroupData,[IsPermGroup],
+      G->rec(lsreps:=[],stabsizes:=[],imagecaches:=[],orbadjs:=[]));
+fi;
+# The (mutable) record of the data kept with a permutation group by 
+# the functions below: for each  m  (in position  m+1),  the 
+# lex-least representatives for its orbits on m-subsets,  a dictionary 
+# of the stabilizer sizes of m-subsets,  a cache of their least 
+# images, and a dictionary of their orbit adjacencies. 
+
+CachedLeastSetRepresentatives := function(G,k)
+#
+# Returns  LeastSetRepresentatives(G,k),  computing it only the first
+# time for  G  and  k. 
+#
+local data;
+data:=TransversalPropertiesGroupData(G);
+if not IsBound(data.lsreps[k+1]) then
+   data.lsreps[k+1]:=Immutable(LeastSetRepresentatives(G,k));
+fi;
+return data.lsreps[k+1];
+end;
+
+CachedSetStabilizerSize := function(G,x)
+#
+# Returns  Size(Stabilizer(G,x,OnSets)),  for  x  a subset of 
+# [1..LargestMovedPoint(G)],  computing it only the first time for 
+# G  and  x. 
+#
+local data,m,r,size;
+data:=TransversalPropertiesGroupData(G);
+m:=Length(x);
+if not IsBound(data.stabsizes[m+1]) then
+   data.stabsizes[m+1]:=NewDictionary(1,true);
+fi;
+r:=SetRank(x,LargestMovedPoint(G));
+size:=LookupDictionary(data.stabsizes[m+1],r);
+if size=fail then
+   size:=Size(Stabilizer(G,x,OnSets));
+   AddDictionary(data.stabsizes[m+1],r,size);
+fi;
+return size;
+end;
+
+GroupSmallestImageSetCache := function(G,m)
+#
+# Returns the cache made by  SmallestImageSetCache(G)  kept with  G  
+# for the least images of its m-subsets. 
+#
+local data;
+data:=TransversalPropertiesGroupData(G);
+if not IsBound(data.imagecaches[m+1]) then
+   data.imagecaches[m+1]:=SmallestImageSetCache(G);
+fi;
+return data.imagecaches[m+1];
+end;
+
+CachedOrbAdjacency := function(G,rep)
+#
+# Returns  OrbAdjacency(G,rep),  which is kept with  G  (so that the 
+# adjacencies computed in it are kept too) 
+# if  TRANSVERSALPROPERTIES_cache_orbgraphs=true. 
+#
+local data,m,r,orbadj;
+if not TRANSVERSALPROPERTIES_cache_orbgraphs then
+   return OrbAdjacency(G,rep);
+fi;
+data:=TransversalPropertiesGroupData(G);
+m:=Length(rep);
+if not IsBound(data.orbadjs[m+1]) then
+   data.orbadjs[m+1]:=NewDictionary(1,true);
+fi;
+r:=SetRank(rep,LargestMovedPoint(G));
+orbadj:=LookupDictionary(data.orbadjs[m+1],r);
+if orbadj=fail then
+   orbadj:=OrbAdjacency(G,rep);
+   AddDictionary(data.orbadjs[m+1],r,orbadj);
+fi;
+return orbadj;
+end;
+
+TransversalProperty := function(G,k,orbgraph,A,R,newpoint,done,optional...)
 #
 # Suppose  orbgraph  represents a  G-orbit  of  k-subsets  of  [1..n],
-# such that  n:=LargestMovedPoint(G)  and   2 <= k <= n.
+# such that  n:=LargestMovedPoint(G)  and   2 <= k <= n,  where  orbgraph
+# was made by  OrbAdjacency  or  OrbGraph. 
 # 
 # Let  A  represent an ordered  k-partition  P = [P[1],...,P[k]]
 # of  [1..n],  where  A  is a dense list of length  n  of 
@@ -176,7 +1007,66 @@ TransversalProperty := function(G,k,orbgraph,A,R,newpoint,done)
 #     and  D  forming a transversal of  [Q[1],...,Q[k-1]],
 #     there is an element of  orb  forming a transversal of  Q.
 #
-local transversalproperty,n;
+# The optional parameter  optional[1]  (default: a new cache) must be 
+# a cache made by  SmallestImageSetCache(G),  used for the least 
+# images of the  (k-1)-subsets  met in the search. 
+#
+# The search order is given by  TRANSVERSALPROPERTIES_branch  and 
+# TRANSVERSALPROPERTIES_partorder,  and the number of nodes searched 
+# is added to  TRANSVERSALPROPERTIES_nodes. 
+#
+local transversalproperty,branchpoint,partorder,n,cache,nodes,tp;
+
+branchpoint := function(A,R)
+#
+# Returns the point of the (nonempty) set  R  on which to branch, as 
+# given by  TRANSVERSALPROPERTIES_branch.  For "cover", this is the 
+# least point  s  of  R  lying in the most  k-subsets  in the orbit 
+# whose points other than  s  are in distinct parts (so that putting 
+# s  into the part missed by such a  k-subset  makes it a transversal). 
+#
+local s,score,best,r;
+if TRANSVERSALPROPERTIES_branch="first" then
+   return R[1];
+elif TRANSVERSALPROPERTIES_branch="cover" then
+   best:=-1;
+   for s in R do
+      score:=Number(OrbAdjacencySets(orbgraph,s),
+         y->IsInjectiveListTrans(y,A));
+      if score>best then
+         best:=score;
+         r:=s;
+      fi;
+   od;
+   return r;
+fi;
+return R[Length(R)];
+end;
+
+partorder := function(A)
+#
+# Returns the list of the parts  1,...,k-1  in the order in which they 
+# are to be tried, as given by  TRANSVERSALPROPERTIES_partorder 
+# (with parts of the same size in increasing order for "small" and 
+# "large"). 
+#
+local order,sizes;
+if TRANSVERSALPROPERTIES_partorder="down" then
+   return [k-1,k-2..1];
+fi;
+order:=[1..k-1];
+if TRANSVERSALPROPERTIES_partorder="small" 
+   or TRANSVERSALPROPERTIES_partorder="large" then
+   sizes:=List(order,i->Number(A,a->a=i));
+   if TRANSVERSALPROPERTIES_partorder="large" then
+      sizes:=-sizes;
+   fi;
+   order:=ShallowCopy(order);
+   Sort(order,function(i,j) 
+      return sizes[i]<sizes[j] or (sizes[i]=sizes[j] and i<j); end);
+fi;
+return order;
+end;
 
 transversalproperty := function(A,asum,R,newpoint)
 #
@@ -185,9 +1075,10 @@ transversalproperty := function(A,asum,R,newpoint)
 # asum  is the number of elements of  A  that are  < k.
 # It is assumed that  asum+Length(R) <= (k-1)*n/k. 
 #
-local v,K,r,tp,i,kpoint;
-for v in Adjacency(orbgraph,newpoint) do
-   K:=Concatenation(orbgraph.names[v],[newpoint]);
+local y,K,r,tp,i,kpoint;
+nodes:=nodes+1;
+for y in OrbAdjacencySets(orbgraph,newpoint) do
+   K:=Concatenation(y,[newpoint]);
    if IsInjectiveListTrans(K,A) then
       # A[K[1]],...,A[K[k]]  are distinct, so  K  forms a transversal of  P.
       kpoint:=First(K,x->A[x]=k);
@@ -197,7 +1088,7 @@ for v in Adjacency(orbgraph,newpoint) do
          # No counterexample exists.
          return true;
       elif done<>[] then
-         if SmallestImageSet(G,Difference(K,[kpoint])) in done then
+         if CachedSmallestImageSet(cache,Difference(K,[kpoint])) in done then
             return true;
          fi;
       fi;
@@ -208,8 +1099,9 @@ if R=[] then
    # defined by  A.
    return GRAPE_NumbersToSets(A);
 fi;
-r:=Remove(R);
-for i in [1..k-1] do
+r:=branchpoint(A,R);
+RemoveSet(R,r);
+for i in partorder(A) do
    # Try to build a counterexample with  r  in the  i-th part.
    A[r]:=i;
    tp:=transversalproperty(A,asum+1,ShallowCopy(R),r);
@@ -229,17 +1121,37 @@ n:=LargestMovedPoint(G);
 if k<2 or k>n then
    Error("must have 2 <= <k> <= LargestMovedPoint(<G>)");
 fi;
-return transversalproperty(A,Number(A,a->a<k),ShallowCopy(R),newpoint);
+if Length(optional)>0 then
+   cache:=optional[1];
+else
+   cache:=SmallestImageSetCache(G);
+fi;
+if not TRANSVERSALPROPERTIES_branch in ["first","last","cover"] then
+   Error("TransversalProperty: TRANSVERSALPROPERTIES_branch must be ",
+      "\"first\", \"last\" or \"cover\"");
+fi;
+if not TRANSVERSALPROPERTIES_partorder in ["up","down","small","large"] then
+   Error("TransversalProperty: TRANSVERSALPROPERTIES_partorder must be ",
+      "\"up\", \"down\", \"small\" or \"large\"");
+fi;
+nodes:=0;
+tp:=transversalproperty(A,Number(A,a->a<k),ShallowCopy(R),newpoint);
+TRANSVERSALPROPERTIES_nodes:=TRANSVERSALPROPERTIES_nodes+nodes;
+Info(TRANSVERSALPROPERTIES_info,3,"TransversalProperty: nodes=",nodes);
+return tp;
 end;
 
-tpmain:=function(G,rep,shortreps) 
+tpmain:=function(G,rep,shortreps,optional...) 
 #
 # Let  G  be a permutation group on  [1..n],  where  n  is the
 # largest point moved by  G,  and let  k:=Length(rep).
 #
-# This boolean function determines whether, for each
-# k-partition of  [1..n],  there is a transversal in 
-# the G-orbit of the k-set rep.
+# This function returns `true' if, for each k-partition of  [1..n], 
+# there is a transversal in the G-orbit of the k-set rep.
+# Otherwise, it returns a counterexample, that is, an ordered 
+# k-partition  Q  of  [1..n]  (as a list of sets) of which no k-set  
+# in the G-orbit of rep is a transversal (or `false' if the external 
+# program gives no counterexample).
 # 
 # The parameter  shortreps  should be a list consisting of the lex-least
 # representatives for the  G-orbits  of  (k-1)-subsets of  [1..n].
@@ -247,69 +1159,81 @@ tpmain:=function(G,rep,shortreps)
 # It is assumed that  2<=k<=n. 
 #
 # This function makes use of the external C program tpexternal, 
-# unless TRANSVERSALPROPERTIES_tpexternal_maxnum<=0 or 
-# G  is not transitive on  [1..n].
+# unless TRANSVERSALPROPERTIES_tpexternal_maxnum<=0.  If  
+# TRANSVERSALPROPERTIES_tpexternal_server=true,  then the session 
+# with tpexternal for  G  and  k  is (re)used, and otherwise if 
+# TRANSVERSALPROPERTIES_tpexternal_pipes=true,  then tpexternal is 
+# run without using files. 
+#
+# The optional parameter  optional[1]  (default: the cache kept with 
+# G,  by  GroupSmallestImageSetCache(G,k-1))  must be a cache made by 
+# SmallestImageSetCache(G),  used for the least images of the 
+# (k-1)-subsets  needed (so that a cache can be shared by the calls 
+# of  tpmain  for the same  G  and  k). 
 #
-local n,k,in_file,in_stream,out_file,out_stream,status,result,done,i,A,
-   tp,tpexternal_num,orbgraph;
+local n,k,result,done,i,A,tp,tpexternal_num,orbgraph,stream,cache,args,
+   output;
 n:=LargestMovedPoint(G);
 k:=Length(rep);
 if k<2 or k>n then
    Error("must have 2 <= <k> <= LargestMovedPoint(<G>)");
 fi;
-if not IsTransitive(G,[1..n]) then
-   tpexternal_num:=0;
+if Length(optional)>0 then
+   cache:=optional[1];
 else
-   tpexternal_num:=
-      Minimum(TRANSVERSALPROPERTIES_tpexternal_maxnum,Length(shortreps));
+   cache:=GroupSmallestImageSetCache(G,k-1);
 fi;
-orbgraph:=OrbGraph(G,rep);
-if tpexternal_num>0 then
+tpexternal_num:=
+   Minimum(TRANSVERSALPROPERTIES_tpexternal_maxnum,Length(shortreps));
+if tpexternal_num<0 then
+   tpexternal_num:=0;
+fi;
+orbgraph:=CachedOrbAdjacency(G,rep);
+if tpexternal_num>0 and TRANSVERSALPROPERTIES_tpexternal_server then
+   # We make use of the external C program, running in server mode.
+   args:=TpexternalArgs(G,tpexternal_num);
+   stream:=TpexternalSession(G,k,args);
+   Info(TRANSVERSALPROPERTIES_info,3,
+      "Runtimes in milliseconds before calling tpexternal: ",Runtimes());
+   PrintStreamTpexternalJob(stream,G,orbgraph,shortreps{[1..tpexternal_num]},
+      false,cache);
+   result:=TpexternalReadOutput(stream,args);
+   Info(TRANSVERSALPROPERTIES_info,3,
+      "Runtimes in milliseconds after calling tpexternal: ",Runtimes());
+   if result=fail then
+      TpexternalCloseSession();
+   fi;
+elif tpexternal_num>0 then
    # We make use of the external C program.
-   in_file:=Filename(TRANSVERSALPROPERTIES_tmpdir,"in_file");
-   out_file:=Filename(TRANSVERSALPROPERTIES_tmpdir,"out_file");
-   RemoveFile(in_file);  # in case there is a leftover copy
-   RemoveFile(out_file); # in case there is a leftover copy
-   in_stream:=OutputTextFile(in_file,false);
-   if in_stream=fail then
-       Error("tpmain: error opening output text stream using file ",in_file); 
-   fi;
-   SetPrintFormattingStatus(in_stream,false);
-   PrintStreamTpexternalInput(in_stream,G,k,orbgraph,
-      shortreps{[1..tpexternal_num]});
-   CloseStream(in_stream);
-   in_stream:=InputTextFile(in_file);
-   if in_stream=fail then
-      Error("tpmain: error opening input text stream using file ",in_file);
-   fi;
-   out_stream:=OutputTextFile(out_file,false);
-   if out_stream=fail then
-       Error("tpmain: error opening output text stream using file ",out_file);
-   fi;
-   SetPrintFormattingStatus(out_stream,false);
    Info(TRANSVERSALPROPERTIES_info,3,
       "Runtimes in milliseconds before calling tpexternal: ",Runtimes());
-   status:=GRAPE_Exec(TRANSVERSALPROPERTIES_tpexternal_exe, 
-      [],in_stream,out_stream);
+   args:=TpexternalArgs(G,tpexternal_num);
+   result:=TpexternalRun(args,function(stream,binary)
+      if binary then
+         WriteAll(stream,"TPB1");
+      fi;
+      PrintStreamTpexternalGroup(stream,G,k,binary,args);
+      PrintStreamTpexternalJob(stream,G,orbgraph,
+         shortreps{[1..tpexternal_num]},binary,cache);
+      end);
    Info(TRANSVERSALPROPERTIES_info,3,
       "Runtimes in milliseconds after calling tpexternal: ",Runtimes());
-   if status<>0 then
-     Error("tpmain: exit code ",status," returned by tpexternal;\n",
-      "returned results may be wrong");
-   fi;
-   CloseStream(out_stream);
-   out_stream:=InputTextFile(out_file);
-   result:=ReadLine(out_stream);
-   CloseStream(in_stream); 
-   CloseStream(out_stream); 
-   RemoveFile(in_file);
-   RemoveFile(out_file);
+fi;
+if tpexternal_num>0 then
    if result=fail then
       Error("tpmain: result unavailable");
    fi;
-   result:=Int(Chomp(result));
+   output:=result;
+   result:=TpexternalResult(output);
    if result=0 then
-      return false;
+      tp:=TpexternalCounterexample(output);
+      if tp=fail then
+         return false;
+      fi;
+      Info(TRANSVERSALPROPERTIES_info,2,
+         "tpmain returns a counterexample for rep=",rep,
+         "  first k-1 parts = ",tp{[1..k-1]});
+      return tp;
    fi;
    if result<>1 then 
       Error("tpmain: invalid result");
@@ -328,15 +1252,15 @@ for i in [tpexternal_num+1..Length(shortreps)] do
    Info(TRANSVERSALPROPERTIES_info,3,
       "Runtimes in milliseconds before calling TransversalProperty: ",
       Runtimes());
-   tp:=TransversalProperty(G,k,orbgraph,A,[],shortreps[i][1],done);
+   tp:=TransversalProperty(G,k,orbgraph,A,[],shortreps[i][1],done,cache);
    Info(TRANSVERSALPROPERTIES_info,3,
       "Runtimes in milliseconds after calling TransversalProperty: ",
       Runtimes());
    if tp<>true then
       Info(TRANSVERSALPROPERTIES_info,2,
-         "tpmain returns false for rep=",rep,"  shortrep=",shortreps[i],
-         "  first k-1 parts = ",tp{[1..k-1]});
-      return false;
+         "tpmain returns a counterexample for rep=",rep,
+         "  shortrep=",shortreps[i],"  first k-1 parts = ",tp{[1..k-1]});
+      return tp;
    else
       AddSet(done,shortreps[i]);
    fi;
@@ -344,41 +1268,21 @@ od;
 return true;
 end;
 
-UniversalTransversalProperty := function(G,k,optional...)
+UniversalTransversalPropertySetup := function(G,k,C,lsreps)
 #
-# Suppose  G  is a permutation group on the domain
-# [1..n],  where  n  is the largest point moved by  G,  and
-# suppose  k  is an integer, with  2 <= k <= n.
-#
-# Then this function returns `true' if  G  has the property k-ut, 
-# that is, for every  k-partition  P  of  [1..n]  and every 
-# k-subset  K  of  [1..n],  there is a set in the  G-orbit  of  K
-# which is a transversal of  P.
+# Does the work of  UniversalTransversalProperty(G,k,C)  before its 
+# orbit reps are tested, using the function  lsreps  in place 
+# of  LeastSetRepresentatives  (for example, to reuse the 
+# representatives computed for other values of  k). 
 #
-# Otherwise, this function returns `false'.
+# Returns `true' or `false' if this already decides whether  G  has 
+# the property k-ut, and otherwise returns a record with components 
+# reps  (the orbit reps to be tested by  tpmain,  in order),  shortreps
+# and  cache  (as needed by  tpmain). 
 #
-# The optional parameter optional[1] (default: G) must be a 
-# permutation group on  [1..n],  containing  G  and normalizing  G.
-# The use of this parameter may save some redundant checks of 
-# G-orbits  of  k-subsets.
-# 
-local n,reps,rep,shortreps,shortrep,subreps,orbgraph,tp,C,A,stabsizes;
-if not (IsPermGroup(G) and IsInt(k)) then
-   Error("usage: UniversalTransversalProperty( <PermGrp>, <Int> [, <PermGrp> ] )");
-fi;
+local n,reps,rep,shortreps,subreps,stabsizes,cache;
 n:=LargestMovedPoint(G);
-if k<2 or k>n then
-   Error("must have 2 <= <k> <= LargestMovedPoint(<G>)");
-fi;
-if Length(optional)>0 then
-   C:=optional[1];
-   if not (IsPermGroup(C) and LargestMovedPoint(C)=n and IsSubgroup(C,G) and IsNormal(C,G)) then
-      Error("<C> must be a permutation group on the same domain as <G>, containing and normalizing <G>");
-   fi;
-else
-   C:=G;
-fi;
-shortreps:=LeastSetRepresentatives(G,k-1);
+shortreps:=lsreps(G,k-1);
 if Length(shortreps)>k then
    # There are *no* witnessing k-sets, so the k-ut property does not hold.
    Info(TRANSVERSALPROPERTIES_info,1,
@@ -386,12 +1290,14 @@ if Length(shortreps)>k then
       Length(shortreps),">k");
    return false;
 fi;
-reps:=LeastSetRepresentatives(C,k);
+reps:=ShallowCopy(lsreps(C,k));
+shortreps:=ShallowCopy(shortreps);
+cache:=GroupSmallestImageSetCache(G,k-1);
 Info(TRANSVERSALPROPERTIES_info,1,
       "UniversalTransversalProperty: Length(shortreps)=",
       Length(shortreps)," Length(reps)=",Length(reps));
 if Length(reps)=1 then
-   if G=C or Length(LeastSetRepresentatives(G,k))=1 then
+   if G=C or Length(lsreps(G,k))=1 then
       # G is k-homogeneous, so the k-ut property holds
       Info(TRANSVERSALPROPERTIES_info,1,
          "UniversalTransversalProperty: G is k-homogeneous");
@@ -399,7 +1305,7 @@ if Length(reps)=1 then
    fi;
 fi;
 for rep in reps do
-   subreps:=Set(Combinations(rep,k-1),x->SmallestImageSet(G,x));
+   subreps:=Set(Combinations(rep,k-1),x->CachedSmallestImageSet(cache,x));
    if not ForAll(shortreps,x->x in subreps) then
       Info(TRANSVERSALPROPERTIES_info,1,
          "UniversalTransversalProperty: rep=",rep,
@@ -408,20 +1314,75 @@ for rep in reps do
       return false;
    fi;
 od;
-stabsizes:=List(reps,x->Size(Stabilizer(G,x,OnSets)));
+stabsizes:=List(reps,x->CachedSetStabilizerSize(G,x));
 SortParallel(stabsizes,reps,function(x,y) return x>y; end);
 Info(TRANSVERSALPROPERTIES_info,2,
       "UniversalTransversalProperty: stabsizes of reps=",
        Collected(stabsizes));
-stabsizes:=List(shortreps,x->Size(Stabilizer(G,x,OnSets)));
+stabsizes:=List(shortreps,x->CachedSetStabilizerSize(G,x));
 SortParallel(stabsizes,shortreps);
 Info(TRANSVERSALPROPERTIES_info,2,
       "UniversalTransversalProperty: stabsizes of shortreps=",
        Collected(stabsizes));
+return rec(reps:=reps,shortreps:=shortreps,cache:=cache);
+end;
+
+UniversalTransversalProperty := function(G,k,optional...)
+#
+# Suppose  G  is a permutation group on the domain
+# [1..n],  where  n  is the largest point moved by  G,  and
+# suppose  k  is an integer, with  2 <= k <= n.
+#
+# Then this function returns `true' if  G  has the property k-ut, 
+# that is, for every  k-partition  P  of  [1..n]  and every 
+# k-subset  K  of  [1..n],  there is a set in the  G-orbit  of  K
+# which is a transversal of  P.
+#
+# Otherwise, this function returns `false'.
+#
+# The optional parameter optional[1] (default: G) must be a 
+# permutation group on  [1..n],  containing  G  and normalizing  G.
+# The use of this parameter may save some redundant checks of 
+# G-orbits  of  k-subsets.
+# 
+local n,reps,rep,shortreps,tp,C,cache,setup;
+if not (IsPermGroup(G) and IsInt(k)) then
+   Error("usage: UniversalTransversalProperty( <PermGrp>, <Int> [, <PermGrp> ] )");
+fi;
+n:=LargestMovedPoint(G);
+if k<2 or k>n then
+   Error("must have 2 <= <k> <= LargestMovedPoint(<G>)");
+fi;
+if Length(optional)>0 then
+   C:=optional[1];
+   if not (IsPermGroup(C) and LargestMovedPoint(C)=n and IsSubgroup(C,G) and IsNormal(C,G)) then
+      Error("<C> must be a permutation group on the same domain as <G>, containing and normalizing <G>");
+   fi;
+else
+   C:=G;
+fi;
+setup:=UniversalTransversalPropertySetup(G,k,C,CachedLeastSetRepresentatives);
+if IsBool(setup) then
+   return setup;
+fi;
+reps:=setup.reps;
+shortreps:=setup.shortreps;
+cache:=setup.cache;
+if TRANSVERSALPROPERTIES_tpexternal_jobs>1 
+   and TRANSVERSALPROPERTIES_tpexternal_maxnum>=Length(shortreps) then
+   rep:=TpexternalParallelReps(G,reps,shortreps,cache,false);
+   if rep<>fail then
+      Info(TRANSVERSALPROPERTIES_info,1,
+         "UniversalTransversalProperty: k-ut does not hold. ",
+         "Orbit of ",rep," fails.");
+      return false;
+   fi;
+   return true;
+fi;
 for rep in reps do
    Info(TRANSVERSALPROPERTIES_info,2,
       "UniversalTransversalProperty: testing orbit of: ",rep);
-   tp:=tpmain(G,rep,shortreps);
+   tp:=tpmain(G,rep,shortreps,cache);
    if tp<>true then
       # G does not have the k-ut property, as orbit of rep does
       # not contain a transversal for some k-partition.
@@ -434,6 +1395,49 @@ od;
 return true;
 end;
 
+ExistentialTransversalPropertyCandidates := function(G,C,shortreps)
+#
+# Suppose  G  is a permutation group on  [1..n],  where  n  is the 
+# largest point moved by  G,  C  is a permutation group on  [1..n] 
+# containing and normalizing  G,  and  shortreps  is the list of the 
+# lex-least representatives for the  G-orbits  of  (k-1)-subsets  of 
+# [1..n],  with  k>=2. 
+#
+# Then this function returns a list of  k-subsets,  including one in 
+# each  C-orbit  whose  k-subsets  contain representatives of all the 
+# (k-1)-subset  orbits  (that is, the possible witnesses for k-et). 
+# As each of these contains an image of every shortrep  s,  its orbit 
+# contains  Union(s,[x])  for some  x  not in  s,  and  x  need only 
+# be taken from a set of representatives of the orbits of the 
+# stabilizer of  s  on the points not in  s  (for the shortrep  s  for 
+# which there are the fewest such orbits). 
+#
+# The  k-subsets  are given in decreasing order of the size of their 
+# set-stabilizers in  G  (the same for a whole  C-orbit,  as  C 
+# normalizes  G),  so that those with the smallest  G-orbits,  whose 
+# searches are the quickest, come first. They are not reduced to the 
+# lex-least representatives of their  C-orbits,  and several may lie 
+# in the same  C-orbit:  this is left to the caller, so that it can 
+# be done for each candidate in turn, stopping at the first witness. 
+#
+local n,best,s,orbs,cands,stabsizes;
+n:=LargestMovedPoint(G);
+best:=fail;
+for s in shortreps do
+   orbs:=Orbits(Stabilizer(G,s,OnSets),Difference([1..n],s));
+   if best=fail or Length(orbs)<Length(best[2]) then 
+      best:=[s,orbs];
+   fi;
+od;
+Info(TRANSVERSALPROPERTIES_info,1,
+      "ExistentialTransversalPropertyCandidates: ",Length(best[2]),
+      " points to add to shortrep ",best[1]);
+cands:=List(best[2],o->Union(best[1],[o[1]]));
+stabsizes:=List(cands,x->-CachedSetStabilizerSize(G,x));
+SortParallel(stabsizes,cands);
+return cands;
+end;
+
 ExistentialTransversalProperty := function(G,k,optional...)
 #
 # Suppose  G  is a permutation group on the domain
@@ -452,8 +1456,21 @@ ExistentialTransversalProperty := function(G,k,optional...)
 # permutation group on  [1..n],  containing  G  and normalizing  G.
 # The use of this parameter may save some redundant checks of 
 # G-orbits  of  k-subsets.
+#
+# If  TRANSVERSALPROPERTIES_et_lazy=true,  then only the candidate 
+# witnesses given by  ExistentialTransversalPropertyCandidates  are 
+# made and tested, in place of all the orbit reps of k-subsets, in 
+# the order given there (largest stabilizer first). Each candidate is 
+# reduced to the lex-least representative of its  C-orbit,  and 
+# checked to contain representatives of all the shortrep orbits, only 
+# when it is reached, so that nothing more is done for the candidates 
+# after the first witness. (When the reps are tested by several runs 
+# of the external program at once, this is done for all the candidates 
+# first, to give these runs the list of reps.) Otherwise the orbit reps 
+# are tested in increasing order of the size of their stabilizers. 
 # 
-local n,reps,rep,shortreps,shortrep,subreps,orbgraph,tp,C,A,stabsizes;
+local n,reps,rep,shortreps,shortrep,subreps,orbgraph,tp,C,A,stabsizes,cache,
+   cand,seen;
 if not (IsPermGroup(G) and IsInt(k)) then
    Error("usage: ExistentialTransversalProperty( <PermGrp>, <Int> [, <PermGrp> ] )");
 fi;
@@ -469,7 +1486,7 @@ if Length(optional)>0 then
 else
    C:=G;
 fi;
-shortreps:=LeastSetRepresentatives(G,k-1);
+shortreps:=ShallowCopy(CachedLeastSetRepresentatives(G,k-1));
 if Length(shortreps)>k then
    # There are *no* witnessing k-sets, so the k-et property cannot hold.
    Info(TRANSVERSALPROPERTIES_info,1,
@@ -477,30 +1494,67 @@ if Length(shortreps)>k then
       Length(shortreps),">k");
    return false;
 fi;
-reps:=LeastSetRepresentatives(C,k);
+if TRANSVERSALPROPERTIES_et_lazy then
+   reps:=ExistentialTransversalPropertyCandidates(G,C,shortreps);
+else
+   reps:=ShallowCopy(CachedLeastSetRepresentatives(C,k));
+fi;
+cache:=GroupSmallestImageSetCache(G,k-1);
 Info(TRANSVERSALPROPERTIES_info,1,
       "ExistentialTransversalProperty: Length(shortreps)=",
       Length(shortreps)," Length(reps)=",Length(reps));
-if Length(reps)=1 then
-   if G=C or Length(LeastSetRepresentatives(G,k))=1 then
+if Length(reps)=1 and not TRANSVERSALPROPERTIES_et_lazy then
+   if G=C or Length(CachedLeastSetRepresentatives(G,k))=1 then
       # G is k-homogeneous, so the k-et property holds
       Info(TRANSVERSALPROPERTIES_info,1,
          "ExistentialTransversalProperty: G is k-homogeneous");
       return true;
    fi;
 fi;
-stabsizes:=List(reps,x->Size(Stabilizer(G,x,OnSets)));
-SortParallel(stabsizes,reps);
-Info(TRANSVERSALPROPERTIES_info,2,
-      "ExistentialTransversalProperty: stabsizes of reps=",
-       Collected(stabsizes));
-stabsizes:=List(shortreps,x->Size(Stabilizer(G,x,OnSets)));
+if not TRANSVERSALPROPERTIES_et_lazy then
+   stabsizes:=List(reps,x->CachedSetStabilizerSize(G,x));
+   SortParallel(stabsizes,reps);
+   Info(TRANSVERSALPROPERTIES_info,2,
+         "ExistentialTransversalProperty: stabsizes of reps=",
+          Collected(stabsizes));
+fi;
+stabsizes:=List(shortreps,x->CachedSetStabilizerSize(G,x));
 SortParallel(stabsizes,shortreps);
 Info(TRANSVERSALPROPERTIES_info,2,
       "ExistentialTransversalProperty: stabsizes of shortreps=",
        Collected(stabsizes));
-for rep in reps do
-   subreps:=Set(Combinations(rep,k-1),x->SmallestImageSet(G,x));
+if TRANSVERSALPROPERTIES_tpexternal_jobs>1 
+   and TRANSVERSALPROPERTIES_tpexternal_maxnum>=Length(shortreps) then
+   if TRANSVERSALPROPERTIES_et_lazy then
+      reps:=DuplicateFreeList(List(reps,x->SmallestImageSet(C,x)));
+   fi;
+   reps:=Filtered(reps,function(rep)
+      subreps:=Set(Combinations(rep,k-1),x->CachedSmallestImageSet(cache,x));
+      return ForAll(shortreps,x->x in subreps);
+      end);
+   if reps=[] then
+      return false;
+   fi;
+   rep:=TpexternalParallelReps(G,reps,shortreps,cache,true);
+   if rep<>fail then
+      Info(TRANSVERSALPROPERTIES_info,1,
+         "ExistentialTransversalProperty: k-et holds with witness: ",rep);
+      return true;
+   fi;
+   return false;
+fi;
+seen:=[];
+for cand in reps do
+   if TRANSVERSALPROPERTIES_et_lazy then
+      rep:=SmallestImageSet(C,cand);
+      if rep in seen then
+         continue;
+      fi;
+      AddSet(seen,rep);
+   else
+      rep:=cand;
+   fi;
+   subreps:=Set(Combinations(rep,k-1),x->CachedSmallestImageSet(cache,x));
    if not ForAll(shortreps,x->x in subreps) then
       Info(TRANSVERSALPROPERTIES_info,1,
          "ExistentialTransversalProperty: rep=",rep,
@@ -510,7 +1564,7 @@ for rep in reps do
    fi;
    Info(TRANSVERSALPROPERTIES_info,2,
       "ExistentialTransversalProperty: testing orbit of: ",rep);
-   tp:=tpmain(G,rep,shortreps);
+   tp:=tpmain(G,rep,shortreps,cache);
    if tp=true then
       # G has the k-et property, witnessed by rep. 
       Info(TRANSVERSALPROPERTIES_info,1,
@@ -521,12 +1575,53 @@ od;
 return false;
 end;
 
+StrongOrbitIndex := function(G,rep)
+#
+# Let  G  be a permutation group on  [1..n],  where  n  is the
+# largest point moved by  G,  and let  rep  be a tuple  [T,U],  where
+# T  is a 2-subset of  [1..n]  and  U  is a  (k-1)-subset  of  [1..n]
+# disjoint from  T. 
+#
+# Then this function returns a record representing the  G-orbit  of 
+# rep  (for  StrongTransversalProperty  and  tpexternal),  in which 
+# the tuples are stored compactly in one list of points, and indexed 
+# by point: 
+#
+#   - points  is the concatenation of the lists  Concatenation(T,U) 
+#     for the tuples  [T,U]  in the orbit,  so that the tuple starting 
+#     at position  p  is given by  points{[p..p+k]}, 
+#   - bypoint[x]  is the set of the positions  p  of the tuples  [T,U] 
+#     such that  x  is in  Union([T[1]],U).
+#
+# The orbit is made from a right transversal of the stabilizer of  rep,  
+# so that the orbit itself is never made as a list of tuples.
+#
+local n,k,points,bypoint,g,T,U,p,x;
+n:=LargestMovedPoint(G);
+k:=Length(rep[2])+1;
+points:=[];
+bypoint:=List([1..n],x->[]);
+for g in RightTransversal(G,Stabilizer(G,rep,OnTuplesSets)) do
+   T:=OnSets(rep[1],g);
+   U:=OnSets(rep[2],g);
+   p:=Length(points)+1;
+   Append(points,T);
+   Append(points,U);
+   Add(bypoint[T[1]],p);
+   for x in U do
+      Add(bypoint[x],p);
+   od;
+od;
+return rec(n:=n,k:=k,points:=points,bypoint:=bypoint);
+end;
+
 StrongTransversalProperty := function(G,k,orb,A)
 #
 # Let  G  be a permutation group on  [1..n],  where  n  is the
-# largest point moved by  G,  and let  orb  be a  G-orbit  of a tuple  
-# [T,U],  where  T  is a 2-subset of  [1..n]  and  U  is a  (k-1)-subset  
-# of  [1..n]  disjoint from  T.  It is assumed that  2 <= k <= n-1. 
+# largest point moved by  G,  and let  orb  represent a  G-orbit  of 
+# a tuple  [T,U],  where  T  is a 2-subset of  [1..n]  and  U  is a  
+# (k-1)-subset  of  [1..n]  disjoint from  T,  as made by 
+# StrongOrbitIndex.  It is assumed that  2 <= k <= n-1. 
 #
 # Let  A  represent an ordered  k-partition  P = [P[1],...,P[k]]
 # of  [1..n],  where  A  is a dense list of length  n  of 
@@ -569,7 +1664,7 @@ strongtransversalproperty := function(A,asum)
 #
 # asum  is the number of elements of  A  that are  < k.
 #
-local elm,a,b,K,r,s,tp,i,kpoint,R,S,gamma;
+local a,b,K,r,s,tp,i,kpoint,R,S,gamma,points,sizes,j,x,p;
 R:=[];
 # R  is maintained as a subset of  [1..n],  such that no element
 # of  R  can be in the  k-th  part of a counterexample. 
@@ -577,15 +1672,25 @@ S:=[];
 # S  is maintained as a set of 2-subsets of  [1..n],  such that,
 # if  [a,b] in S,  then either  a  or  b  (or both) cannot be in
 # the  k-th  part of a counterexample.
-for elm in orb do
+# A transversal  Union([T[1]],U)  of  P  has just one point in the 
+# smallest part  P[j]  with  j<k,  so only the tuples indexed by the 
+# points of  P[j]  need to be considered. 
+points:=orb.points;
+sizes:=ListWithIdenticalEntries(k,0);
+for x in A do
+   sizes[x]:=sizes[x]+1;
+od;
+j:=Position(sizes,Minimum(sizes{[1..k-1]}));
+for p in Concatenation(orb.bypoint{Filtered([1..n],x->A[x]=j)}) do
    # loop invariant: 
    #   -  R  is a subset of  P[k],
    #   -  S  is a set of  2-subsets  of  P[k],  such that
    #      every element of  S  is disjoint from  R.
-   a:=elm[1][1];
-   b:=elm[1][2]; 
+   a:=points[p];
+   b:=points[p+1]; 
    if A[a]=A[b] then
-      K:=Concatenation(elm[2],[a]);
+      K:=points{[p+1..p+k]};
+      K[1]:=a;
       if IsInjectiveListTrans(K,A) then
          # A[K[1]],...,A[K[k]] are distinct, so  K  forms a transversal of  P.
          kpoint:=First(K,x->A[x]=k);
@@ -681,13 +1786,45 @@ strongtpmain:=function(G,rep,shortreps)
 #    - T[1]^g  and  T[2]^g  are in the same part of  P 
 #    - Union([T[1]],U)^g  is a transversal of  P.
 #  
+# This function makes use of the external C program tpexternal (in its
+# strong mode), unless  TRANSVERSALPROPERTIES_tpexternal_maxnum<=0  or 
+# TRANSVERSALPROPERTIES_tpexternal_strong=false. 
+#
 local n,k,orb,result,i,A,tp;
 n:=LargestMovedPoint(G);
 k:=Length(rep[2])+1;
 if k<2 or k>n-1 then
    Error("must have 2 <= <k> <= LargestMovedPoint(<G>)-1");
 fi;
-orb:=Set(Orbit(G,rep,OnTuplesSets)); 
+orb:=StrongOrbitIndex(G,rep); 
+if TRANSVERSALPROPERTIES_tpexternal_maxnum>0 
+   and TRANSVERSALPROPERTIES_tpexternal_strong then
+   # We make use of the external C program, in its strong mode.
+   Info(TRANSVERSALPROPERTIES_info,3,
+      "Runtimes in milliseconds before calling tpexternal: ",Runtimes());
+   result:=TpexternalRun(["-S"],function(stream,binary)
+      if binary then
+         WriteAll(stream,Concatenation("TPB1",TpexternalBinaryString([n,k])));
+      else
+         WriteAll(stream,Concatenation(String(n)," ",String(k)));
+      fi;
+      PrintStreamTpexternalStrongJob(stream,orb,shortreps,binary);
+      end);
+   Info(TRANSVERSALPROPERTIES_info,3,
+      "Runtimes in milliseconds after calling tpexternal: ",Runtimes());
+   if result=fail then
+      Error("strongtpmain: result unavailable");
+   fi;
+   result:=TpexternalResult(result);
+   if result<>0 and result<>1 then 
+      Error("strongtpmain: invalid result");
+   fi;
+   if result=0 then
+      Info(TRANSVERSALPROPERTIES_info,2,
+         "strongtpmain returns false for rep=",rep);
+   fi;
+   return result=1;
+fi;
 for i in [1..Length(shortreps)] do 
    A:=ListWithIdenticalEntries(n,k);
    A{shortreps[i]}:=[1..k-1];
@@ -743,15 +1880,15 @@ if (not testmode) and Transitivity(G,[1..n])>k then
          "StrongUniversalTransversalProperty: Transitivity(G,[1..n])>k");
    return true;
 fi;
-shortreps:=LeastSetRepresentatives(G,k-1);
+shortreps:=CachedLeastSetRepresentatives(G,k-1);
 if (not testmode) and Length(shortreps)>1 then
    Info(TRANSVERSALPROPERTIES_info,1,
       "StrongUniversalTransversalProperty: G is not (k-1)-homogeneous");
    return false;
 fi;
-LL:=LeastSetRepresentatives(C,k+1);
+LL:=CachedLeastSetRepresentatives(C,k+1);
 if not testmode then
-   if Length(LeastSetRepresentatives(G,k))>1 then
+   if Length(CachedLeastSetRepresentatives(G,k))>1 then
       # G is not k-homogeneous
       if not UniversalTransversalProperty(G,k,C) then
          Info(TRANSVERSALPROPERTIES_info,1,
@@ -805,3 +1942,115 @@ for rep in reps do
 od;
 return true;
 end;
+
+TransversalPropertiesBatch := function(groups,ks,dirname,optional...)
+#
+# Suppose  groups  is a list of permutation groups, and  ks  is a list 
+# of integers, and  dirname  is the name of a directory shared by 
+# all the GAP processes (possibly on different machines) taking part 
+# in the batch, each of which should make the same call of this 
+# function. Then the property k-ut is determined for each group  G  
+# in  groups  and each  k  in  ks  with  2 <= k <= LargestMovedPoint(G), 
+# and each result is appended to the results file  "results.g"  in  
+# dirname,  as  
+#
+#    Add(TRANSVERSALPROPERTIES_batch_results,rec(group:=i,k:=k,result:=r));
+#
+# where  groups[i]  has k-ut iff  r=true. 
+#
+# The work units are the orbit reps to be tested by  tpmain.  Each
+# unit is claimed by the process that creates the directory for it in 
+# dirname,  and its result is written to a file of its own, which 
+# is marked as complete (once written) by creating the directory 
+# done_<unit>,  so that the processes share out the work, and an 
+# interrupted batch can be resumed (by making the same call) without 
+# redoing the completed units. For each group, the least set 
+# representatives are computed once for each size (by 
+# CachedLeastSetRepresentatives),  and reused for the successive 
+# values of  k. 
+#
+# If the optional parameter  optional[1]  is given, it must be a record.
+# If this record has the component  reclaim  set to  `true',  then the 
+# units which were claimed but have no result (for example, because 
+# a process working on them was killed) are claimed again. This should 
+# only be done when no other process is working on the batch. 
+#
+# The list of the records in the results file is returned. 
+#
+local dir,options,i,G,k,n,setup,j,unit,file,results,
+   final;
+dir:=Directory(dirname);
+if Length(optional)>0 then
+   options:=optional[1];
+else
+   options:=rec();
+fi;
+final:=function(i,k,r)
+   # records the result  r  for  groups[i]  and  k  (just once)
+   if CreateDir(Filename(dir,Concatenation("final_",String(i),"_",
+      String(k))))=true then
+      AppendTo(Filename(dir,"results.g"),
+         "Add(TRANSVERSALPROPERTIES_batch_results,rec(group:=",i,
+         ",k:=",k,",result:=",r,"));\n");
+   fi;
+   end;
+for i in [1..Length(groups)] do
+   G:=groups[i];
+   n:=LargestMovedPoint(G);
+   for k in ks do
+      if k<2 or k>n then
+         continue;
+      fi;
+      if IsExistingFile(Filename(dir,Concatenation("final_",String(i),"_",
+         String(k)))) then
+         continue;
+      fi;
+      Info(TRANSVERSALPROPERTIES_info,1,
+         "TransversalPropertiesBatch: group ",i,", k=",k);
+      setup:=UniversalTransversalPropertySetup(G,k,G,
+         CachedLeastSetRepresentatives);
+      if IsBool(setup) then
+         final(i,k,setup);
+         continue;
+      fi;
+      results:=[];
+      for j in [1..Length(setup.reps)] do
+         unit:=Concatenation(String(i),"_",String(k),"_",String(j));
+         file:=Filename(dir,Concatenation("unit_",unit,".g"));
+         if IsExistingFile(Filename(dir,Concatenation("done_",unit))) then
+            results[j]:=ReadAsFunction(file)();
+         elif CreateDir(Filename(dir,Concatenation("claim_",unit)))=true
+            or (IsBound(options.reclaim) and options.reclaim=true) then
+            results[j]:=
+               tpmain(G,setup.reps[j],setup.shortreps,setup.cache)=true;
+            PrintTo(file,"return ",results[j],";\n");
+            # only now can the file be read by the other processes
+            CreateDir(Filename(dir,Concatenation("done_",unit)));
+         fi;
+         if IsBound(results[j]) and results[j]=false then
+            final(i,k,false);
+            break;
+         fi;
+      od;
+      # pick up the results of the units completed meanwhile by the 
+      # other processes 
+      for j in [1..Length(setup.reps)] do
+         unit:=Concatenation(String(i),"_",String(k),"_",String(j));
+         file:=Filename(dir,Concatenation("unit_",unit,".g"));
+         if not IsBound(results[j]) 
+            and IsExistingFile(Filename(dir,Concatenation("done_",unit))) then
+            results[j]:=ReadAsFunction(file)();
+         fi;
+      od;
+      if ForAll([1..Length(setup.reps)],j->IsBound(results[j])) then
+         final(i,k,ForAll(results,x->x=true));
+      fi;
+   od;
+od;
+TRANSVERSALPROPERTIES_batch_results:=[];
+file:=Filename(dir,"results.g");
+if IsExistingFile(file) then
+   Read(file);
+fi;
+return TRANSVERSALPROPERTIES_batch_results;
+end;